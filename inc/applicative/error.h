@@ -23,6 +23,7 @@
 // Utils.
 #include "math.h"
 #include "parser.h"
+#include "scheduler.h"
 #include "string.h"
 #include "types.h"
 // Components.
@@ -42,6 +43,7 @@ typedef enum {
 	ERROR_NODE_ADDRESS,
 	ERROR_BUSY_SPY_RUNNING,
 	ERROR_TX_DISABLED,
+	ERROR_EVENT_OVERFLOW,
 	// Peripherals.
 	ERROR_BASE_ADC1 = 0x0100,
 	ERROR_BASE_FLASH = (ERROR_BASE_ADC1 + ADC_ERROR_BASE_LAST),
@@ -64,8 +66,10 @@ typedef enum {
 	ERROR_BASE_NODE = (ERROR_BASE_SH1106 + SH1106_ERROR_BASE_LAST),
 	// Applicative.
 	ERROR_BASE_HMI = (ERROR_BASE_NODE + NODE_ERROR_BASE_LAST),
+	// Utils.
+	ERROR_BASE_SCHEDULER = (ERROR_BASE_HMI + HMI_ERROR_BASE_LAST),
 	// Last index.
-	ERROR_BASE_LAST = (ERROR_BASE_HMI + HMI_ERROR_BASE_LAST)
+	ERROR_BASE_LAST = (ERROR_BASE_SCHEDULER + SCHEDULER_ERROR_BASE_LAST)
 } ERROR_t;
 
 /*** ERROR functions ***/
@@ -48,7 +48,7 @@ typedef enum {
 
 void HMI_init(void);
 HMI_status_t HMI_task(void);
-void HMI_set_irq_flag(HMI_irq_flag_t irq_flag);
+uint8_t HMI_get_activation_flag(void);
 
 #define HMI_status_check(error_base) { if (hmi_status != HMI_SUCCESS) { status = error_base + hmi_status; goto errors; }}
 #define HMI_error_check() { ERROR_status_check(hmi_status, HMI_SUCCESS, ERROR_BASE_HMI); }
@@ -78,6 +78,7 @@ SH1106_status_t SH1106_clear(void);
 SH1106_status_t SH1106_print_text(SH1106_text_t* text);
 SH1106_status_t SH1106_print_horizontal_line(SH1106_horizontal_line_t* horizontal_line);
 SH1106_status_t SH1106_print_image(const uint8_t image[SH1106_SCREEN_HEIGHT_LINE][SH1106_SCREEN_WIDTH_PIXELS]);
+SH1106_status_t SH1106_flush(void);
 
 #define SH1106_status_check(error_base) { if (sh1106_status != SH1106_SUCCESS) { status = error_base + sh1106_status; goto errors; }}
 #define SH1106_error_check() { ERROR_status_check(sh1106_status, SH1106_SUCCESS, ERROR_BASE_SH1106); }
@@ -17,6 +17,27 @@ typedef enum {
 	DMM_REGISTER_NODES_COUNT,
 	DMM_REGISTER_SIGFOX_UL_PERIOD_SECONDS,
 	DMM_REGISTER_SIGFOX_DL_PERIOD_SECONDS,
+	DMM_REGISTER_DEGRADED_NODES_COUNT,
+	DMM_REGISTER_SCAN_BUDGET_MS,
+	DMM_REGISTER_VUSB_MIN_MV,
+	DMM_REGISTER_VUSB_MAX_MV,
+	DMM_REGISTER_VUSB_MEAN_MV,
+	DMM_REGISTER_VUSB_STDDEV_MV,
+	DMM_REGISTER_VRS_MIN_MV,
+	DMM_REGISTER_VRS_MAX_MV,
+	DMM_REGISTER_VRS_MEAN_MV,
+	DMM_REGISTER_VRS_STDDEV_MV,
+	DMM_REGISTER_VHMI_MIN_MV,
+	DMM_REGISTER_VHMI_MAX_MV,
+	DMM_REGISTER_VHMI_MEAN_MV,
+	DMM_REGISTER_VHMI_STDDEV_MV,
+	DMM_REGISTER_STATS_WINDOW,
+	DMM_REGISTER_STATS_NODE_ADDRESS,
+	DMM_REGISTER_STATS_REGISTER_ADDRESS,
+	DMM_REGISTER_STATS_MIN,
+	DMM_REGISTER_STATS_MAX,
+	DMM_REGISTER_STATS_MEAN,
+	DMM_REGISTER_STATS_STDDEV,
 	DMM_REGISTER_LAST,
 } DMM_register_address_t;
 
@@ -27,6 +48,27 @@ typedef enum {
 	DMM_STRING_DATA_INDEX_NODES_COUNT,
 	DMM_STRING_DATA_INDEX_SIGFOX_UL_PERIOD_SECONDS,
 	DMM_STRING_DATA_INDEX_SIGFOX_DL_PERIOD_SECONDS,
+	DMM_STRING_DATA_INDEX_DEGRADED_NODES_COUNT,
+	DMM_STRING_DATA_INDEX_SCAN_BUDGET_MS,
+	DMM_STRING_DATA_INDEX_VUSB_MIN_MV,
+	DMM_STRING_DATA_INDEX_VUSB_MAX_MV,
+	DMM_STRING_DATA_INDEX_VUSB_MEAN_MV,
+	DMM_STRING_DATA_INDEX_VUSB_STDDEV_MV,
+	DMM_STRING_DATA_INDEX_VRS_MIN_MV,
+	DMM_STRING_DATA_INDEX_VRS_MAX_MV,
+	DMM_STRING_DATA_INDEX_VRS_MEAN_MV,
+	DMM_STRING_DATA_INDEX_VRS_STDDEV_MV,
+	DMM_STRING_DATA_INDEX_VHMI_MIN_MV,
+	DMM_STRING_DATA_INDEX_VHMI_MAX_MV,
+	DMM_STRING_DATA_INDEX_VHMI_MEAN_MV,
+	DMM_STRING_DATA_INDEX_VHMI_STDDEV_MV,
+	DMM_STRING_DATA_INDEX_STATS_WINDOW,
+	DMM_STRING_DATA_INDEX_STATS_NODE_ADDRESS,
+	DMM_STRING_DATA_INDEX_STATS_REGISTER_ADDRESS,
+	DMM_STRING_DATA_INDEX_STATS_MIN,
+	DMM_STRING_DATA_INDEX_STATS_MAX,
+	DMM_STRING_DATA_INDEX_STATS_MEAN,
+	DMM_STRING_DATA_INDEX_STATS_STDDEV,
 	DMM_STRING_DATA_INDEX_LAST,
 } DMM_string_data_index_t;
 
@@ -42,6 +84,27 @@ static const STRING_format_t DMM_REGISTERS_FORMAT[DMM_NUMBER_OF_SPECIFIC_REGISTE
 	STRING_FORMAT_DECIMAL,
 	STRING_FORMAT_DECIMAL,
 	STRING_FORMAT_DECIMAL,
+	STRING_FORMAT_DECIMAL,
+	STRING_FORMAT_DECIMAL,
+	STRING_FORMAT_DECIMAL,
+	STRING_FORMAT_DECIMAL,
+	STRING_FORMAT_DECIMAL,
+	STRING_FORMAT_DECIMAL,
+	STRING_FORMAT_DECIMAL,
+	STRING_FORMAT_DECIMAL,
+	STRING_FORMAT_DECIMAL,
+	STRING_FORMAT_DECIMAL,
+	STRING_FORMAT_DECIMAL,
+	STRING_FORMAT_DECIMAL,
+	STRING_FORMAT_DECIMAL,
+	STRING_FORMAT_DECIMAL,
+	STRING_FORMAT_DECIMAL,
+	STRING_FORMAT_HEXADECIMAL,
+	STRING_FORMAT_HEXADECIMAL,
+	STRING_FORMAT_DECIMAL,
+	STRING_FORMAT_DECIMAL,
+	STRING_FORMAT_DECIMAL,
+	STRING_FORMAT_DECIMAL,
 };
 
 /*** DMM functions ***/
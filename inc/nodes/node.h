@@ -11,6 +11,8 @@
 #include "adc.h"
 #include "lptim.h"
 #include "lpuart.h"
+#include "math.h"
+#include "nvm.h"
 #include "string.h"
 #include "types.h"
 
@@ -51,7 +53,7 @@ typedef enum {
 	NODE_ERROR_NONE_RADIO_MODULE,
 	NODE_ERROR_SIGFOX_PAYLOAD_TYPE,
 	NODE_ERROR_SIGFOX_PAYLOAD_EMPTY,
-	NODE_ERROR_SIGFOX_LOOP,
+	NODE_ERROR_SIGFOX_LOOP, // Not used anymore, kept so that the following error codes do not change.
 	NODE_ERROR_SIGFOX_SEND,
 	NODE_ERROR_SIGFOX_READ,
 	NODE_ERROR_SIGFOX_UPLINK_PERIOD,
@@ -60,11 +62,19 @@ typedef enum {
 	NODE_ERROR_DOWNLINK_BOARD_ID,
 	NODE_ERROR_DOWNLINK_OPERATION_CODE,
 	NODE_ERROR_ACTION_INDEX,
+	NODE_ERROR_ACTION_OVERFLOW,
+	NODE_ERROR_SCAN_BUDGET,
+	NODE_ERROR_STATISTICS_WINDOW,
+	NODE_ERROR_LBUS_FRAME_SIZE,
+	NODE_ERROR_ACTION_WRITE,
+	NODE_ERROR_SIGFOX_PAYLOAD_FULL,
 	NODE_ERROR_BASE_ADC = 0x0100,
 	NODE_ERROR_BASE_LPUART = (NODE_ERROR_BASE_ADC + ADC_ERROR_BASE_LAST),
 	NODE_ERROR_BASE_LPTIM = (NODE_ERROR_BASE_LPUART + LPUART_ERROR_BASE_LAST),
 	NODE_ERROR_BASE_STRING = (NODE_ERROR_BASE_LPTIM + LPTIM_ERROR_BASE_LAST),
-	NODE_ERROR_BASE_LAST = (NODE_ERROR_BASE_STRING + STRING_ERROR_BASE_LAST)
+	NODE_ERROR_BASE_NVM = (NODE_ERROR_BASE_STRING + STRING_ERROR_BASE_LAST),
+	NODE_ERROR_BASE_MATH = (NODE_ERROR_BASE_NVM + NVM_ERROR_BASE_LAST),
+	NODE_ERROR_BASE_LAST = (NODE_ERROR_BASE_MATH + MATH_ERROR_BASE_LAST)
 } NODE_status_t;
 
 typedef uint8_t	NODE_address_t;
@@ -118,6 +128,14 @@ typedef struct {
 	uint8_t extracted_length;
 } NODE_read_data_t;
 
+typedef struct {
+	NODE_address_t node_address;
+	uint8_t register_address; // First register address.
+	uint8_t number_of_registers;
+	uint32_t timeout_ms;
+	STRING_format_t* format; // Expected value format of each register (indexed by register address).
+} NODE_burst_read_parameters_t;
+
 typedef struct {
 	NODE_address_t node_address;
 	uint8_t register_address;
@@ -136,12 +154,18 @@ typedef union {
 	uint8_t all;
 } NODE_access_status_t;
 
+typedef struct {
+	int32_t* value; // Indexed by register address.
+	NODE_access_status_t* status; // Indexed by register address.
+} NODE_burst_read_data_t;
+
 typedef struct {
 	NODE_address_t node_address;
 	uint8_t string_data_index;
 	char_t* name_ptr;
 	char_t* value_ptr;
 	int32_t* registers_value_ptr;
+	NODE_access_status_t* registers_status_ptr;
 } NODE_data_update_t;
 
 typedef enum {
@@ -159,9 +183,13 @@ NODE_list_t NODES_LIST;
 
 void NODE_init(void);
 NODE_status_t NODE_scan(void);
+NODE_status_t NODE_warm_scan(void);
 
 NODE_status_t NODE_update_data(NODE_t* node, uint8_t string_data_index);
-NODE_status_t NODE_update_all_data(NODE_t* node);
+NODE_status_t NODE_start_update_all_data(NODE_t* node);
+NODE_status_t NODE_update_pending_data(NODE_t* node, uint8_t string_data_index);
+uint8_t NODE_get_data_pending_flag(uint8_t string_data_index);
+NODE_status_t NODE_update_registers(NODE_t* node);
 
 NODE_status_t NODE_get_name(NODE_t* node, char_t** board_name);
 NODE_status_t NODE_get_last_string_data_index(NODE_t* node, uint8_t* last_string_data_index);
@@ -173,6 +201,24 @@ uint32_t NODE_get_sigfox_dl_period(void);
 NODE_status_t NODE_set_sigfox_ul_period(uint32_t ul_period_seconds);
 NODE_status_t NODE_set_sigfox_dl_period(uint32_t dl_period_seconds);
 
+uint32_t NODE_get_cache_ttl(void);
+void NODE_set_cache_ttl(uint32_t cache_ttl_seconds);
+
+uint32_t NODE_get_scan_budget(void);
+NODE_status_t NODE_set_scan_budget(uint32_t scan_budget_ms);
+
+NODE_address_t NODE_get_statistics_node_address(void);
+uint8_t NODE_get_statistics_register_address(void);
+uint16_t NODE_get_statistics_window(void);
+void NODE_set_statistics_node_address(NODE_address_t node_address);
+NODE_status_t NODE_set_statistics_register_address(uint8_t register_address);
+NODE_status_t NODE_set_statistics_window(uint16_t statistics_window);
+NODE_status_t NODE_get_statistics(MATH_statistics_result_t* statistics);
+
+uint8_t NODE_get_degraded_flag(NODE_t* node);
+uint8_t NODE_get_degraded_count(void);
+
+uint32_t NODE_get_next_time_seconds(void);
 NODE_status_t NODE_task(void);
 
 #define NODE_append_string_name(str) { \
@@ -185,6 +231,11 @@ NODE_status_t NODE_task(void);
 	STRING_status_check(NODE_ERROR_BASE_STRING); \
 }
 
+#define NODE_append_string_value_int32(value, format, print_prefix) { \
+	string_status = STRING_append_value((data_update -> value_ptr), NODE_STRING_BUFFER_SIZE, value, format, print_prefix, &buffer_size); \
+	STRING_status_check(NODE_ERROR_BASE_STRING); \
+}
+
 #define NODE_flush_string_value(void) { \
 	uint8_t char_idx = 0; \
 	for (char_idx=0 ; char_idx<NODE_STRING_BUFFER_SIZE ; char_idx++) { \
@@ -55,7 +55,9 @@ static const STRING_format_t R4S8CR_REGISTERS_FORMAT[R4S8CR_REGISTER_LAST] = {
 /*** R4S8CR functions ***/
 
 NODE_status_t R4S8CR_read_register(NODE_read_parameters_t* read_params, NODE_read_data_t* read_data, NODE_access_status_t* read_status);
+NODE_status_t R4S8CR_read_registers(NODE_burst_read_parameters_t* read_params, NODE_burst_read_data_t* read_data);
 NODE_status_t R4S8CR_write_register(NODE_write_parameters_t* write_params, NODE_access_status_t* write_status);
+NODE_status_t R4S8CR_probe(NODE_address_t node_address, NODE_t* node, uint8_t* node_found);
 NODE_status_t R4S8CR_scan(NODE_t* nodes_list, uint8_t nodes_list_size, uint8_t* nodes_count);
 NODE_status_t R4S8CR_update_data(NODE_data_update_t* data_update);
 NODE_status_t R4S8CR_get_sigfox_ul_payload(int32_t* integer_data_value, NODE_sigfox_ul_payload_type_t ul_payload_type, uint8_t* ul_payload, uint8_t* ul_payload_size);
@@ -17,6 +17,9 @@
 
 #define UHFM_SIGFOX_UL_PAYLOAD_SIZE_MAX		12
 #define UHFM_SIGFOX_DL_PAYLOAD_SIZE			8
+// Downlink reception window opens about 20 seconds after the uplink and a bidirectional transaction lasts at most 60 seconds.
+#define UHFM_SIGFOX_DOWNLINK_DELAY_SECONDS		20
+#define UHFM_SIGFOX_DOWNLINK_DURATION_SECONDS	60
 
 /*** UHFM structures ***/
 
@@ -50,6 +53,7 @@ static const STRING_format_t UHFM_REGISTERS_FORMAT[UHFM_NUMBER_OF_SPECIFIC_REGIS
 NODE_status_t UHFM_update_data(NODE_data_update_t* data_update);
 NODE_status_t UHFM_get_sigfox_ul_payload(int32_t* integer_data_value, NODE_sigfox_ul_payload_type_t ul_payload_type, uint8_t* ul_payload, uint8_t* ul_payload_size);
 NODE_status_t UHFM_send_sigfox_message(NODE_address_t node_address, UHFM_sigfox_message_t* sigfox_message, NODE_access_status_t* send_status);
+NODE_status_t UHFM_start_sigfox_message(NODE_address_t node_address, UHFM_sigfox_message_t* sigfox_message, NODE_access_status_t* send_status);
 NODE_status_t UHFM_get_dl_payload(NODE_address_t node_address, uint8_t* dl_payload, NODE_access_status_t* read_status);
 
 #endif /* __UHFM_H__ */
@@ -22,6 +22,7 @@ typedef enum {
 	ADC_ERROR_CONVERSION_TYPE,
 	ADC_ERROR_TIMEOUT,
 	ADC_ERROR_DATA_INDEX,
+	ADC_ERROR_STATISTICS_WINDOW,
 	ADC_ERROR_BASE_LPTIM = 0x0100,
 	ADC_ERROR_BASE_MATH = (ADC_ERROR_BASE_LPTIM + LPTIM_ERROR_BASE_LAST),
 	ADC_ERROR_BASE_LAST = (ADC_ERROR_BASE_MATH + MATH_ERROR_BASE_LAST)
@@ -41,6 +42,9 @@ ADC_status_t ADC1_init(void);
 ADC_status_t ADC1_perform_measurements(void);
 ADC_status_t ADC1_get_data(ADC_data_index_t data_idx, uint32_t* data);
 ADC_status_t ADC1_get_tmcu(int8_t* tmcu_degrees);
+ADC_status_t ADC1_get_statistics(ADC_data_index_t data_idx, MATH_statistics_result_t* statistics);
+ADC_status_t ADC1_set_statistics_window(uint16_t statistics_window);
+uint16_t ADC1_get_statistics_window(void);
 
 #define ADC1_status_check(error_base) { if (adc1_status != ADC_SUCCESS) { status = error_base + adc1_status; goto errors; }}
 #define ADC1_error_check() { ERROR_status_check(adc1_status, ADC_SUCCESS, ERROR_BASE_ADC1); }
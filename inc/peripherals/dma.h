@@ -0,0 +1,39 @@
+/*
+ * dma.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __DMA_H__
+#define __DMA_H__
+
+#include "types.h"
+
+/*** DMA structures ***/
+
+typedef void (*DMA_transfer_error_cb_t)(void);
+
+/*** DMA functions ***/
+
+void DMA1_CH1_init(void);
+void DMA1_CH1_start(void);
+void DMA1_CH1_stop(void);
+void DMA1_CH1_set_destination_address(uint32_t destination_buffer_addr, uint16_t destination_buffer_size);
+uint8_t DMA1_CH1_get_transfer_status(void);
+
+void DMA1_CH2_init(void);
+void DMA1_CH2_start(void);
+void DMA1_CH2_stop(void);
+void DMA1_CH2_set_source_address(uint32_t source_buffer_addr, uint16_t source_buffer_size);
+
+void DMA1_CH3_init(void);
+void DMA1_CH3_start(void);
+void DMA1_CH3_stop(void);
+void DMA1_CH3_set_destination_address(uint32_t destination_buffer_addr, uint16_t destination_buffer_size);
+
+void DMA1_CH2_3_set_transfer_error_callback(DMA_transfer_error_cb_t transfer_error_callback, uint8_t priority);
+void DMA1_CH2_3_enable_interrupt(void);
+void DMA1_CH2_3_disable_interrupt(void);
+
+#endif /* __DMA_H__ */
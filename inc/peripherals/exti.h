@@ -59,7 +59,4 @@ void EXTI_configure_line(EXTI_line_t line, EXTI_trigger_t trigger);
 void EXTI_clear_flag(EXTI_line_t line);
 void EXTI_clear_all_flags(void);
 
-uint8_t EXTI_get_encoder_switch_flag(void);
-void EXTI_clear_encoder_switch_flag(void);
-
 #endif /* __EXTI_H__ */
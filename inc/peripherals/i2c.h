@@ -23,16 +23,33 @@ typedef enum {
 	I2C_ERROR_RX_TIMEOUT,
 	I2C_ERROR_TRANSFER_COMPLETE,
 	I2C_ERROR_STOP_DETECTION_FLAG,
+	I2C_ERROR_SPEED,
+	I2C_ERROR_QUEUE_FULL,
+	I2C_ERROR_NACK,
+	I2C_ERROR_BUS,
+	I2C_ERROR_DMA,
 	I2C_ERROR_LAST,
 	I2C_ERROR_BASE_LPTIM = 0x0100,
 	I2C_ERROR_BASE_LAST = (I2C_ERROR_BASE_LPTIM + LPTIM_ERROR_BASE_LAST)
 } I2C_status_t;
 
+typedef enum {
+	I2C_SPEED_400KHZ = 0,
+	I2C_SPEED_1MHZ,
+	I2C_SPEED_LAST
+} I2C_speed_t;
+
+typedef void (*I2C_completion_cb_t)(I2C_status_t transfer_status);
+
 /*** I2C functions ***/
 
 void I2C1_init(void);
+I2C_status_t I2C1_set_speed(I2C_speed_t speed);
 I2C_status_t I2C1_power_on(void);
 void I2C1_power_off(void);
+I2C_status_t I2C1_write_async(uint8_t slave_address, uint8_t* tx_buf, uint8_t tx_buf_length, uint8_t stop_flag, I2C_completion_cb_t completion_callback);
+I2C_status_t I2C1_read_async(uint8_t slave_address, uint8_t* rx_buf, uint8_t rx_buf_length, I2C_completion_cb_t completion_callback);
+I2C_status_t I2C1_wait(uint8_t pending_max);
 I2C_status_t I2C1_write(uint8_t slave_address, uint8_t* tx_buf, uint8_t tx_buf_length, uint8_t stop_flag);
 I2C_status_t I2C1_read(uint8_t slave_address, uint8_t* rx_buf, uint8_t rx_buf_length);
 
@@ -35,6 +35,7 @@ LPTIM_status_t LPTIM1_delay_milliseconds(uint32_t delay_ms, LPTIM_delay_mode_t d
 LPTIM_status_t LPTIM1_start(uint32_t delay_ms);
 void LPTIM1_stop(void);
 uint8_t LPTIM1_get_wake_up_flag(void);
+uint32_t LPTIM1_get_elapsed_milliseconds(void);
 
 #define LPTIM1_status_check(error_base) { if (lptim1_status != LPTIM_SUCCESS) { status = error_base + lptim1_status; goto errors; }}
 #define LPTIM1_error_check() { ERROR_status_check(lptim1_status, LPTIM_SUCCESS, ERROR_BASE_LPTIM1); }
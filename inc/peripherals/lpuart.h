@@ -32,11 +32,13 @@ typedef enum {
 } LPUART_rx_mode_t;
 
 typedef void (*LPUART_rx_callback_t)(uint8_t rx_byte);
+typedef void (*LPUART_tx_callback_t)(void);
 
 typedef struct {
 	uint32_t baud_rate;
 	LPUART_rx_mode_t rx_mode;
 	LPUART_rx_callback_t rx_callback;
+	LPUART_tx_callback_t tx_callback; // Called under interrupt when the last byte has been sent.
 } LPUART_config_t;
 
 /*** LPUART functions ***/
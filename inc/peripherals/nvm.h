@@ -12,6 +12,8 @@
 
 /*** NVM macros ***/
 
+#define NVM_NODES_LIST_SIZE_BYTES	64 // Address and board ID of up to 32 nodes.
+
 typedef enum {
 	NVM_SUCCESS = 0,
 	NVM_ERROR_NULL_PARAMETER,
@@ -24,7 +26,9 @@ typedef enum {
 
 typedef enum {
 	NVM_ADDRESS_SELF_ADDRESS = 0,
-	NVM_ADDRESS_LAST
+	NVM_ADDRESS_NODES_LIST_COUNT,
+	NVM_ADDRESS_NODES_LIST,
+	NVM_ADDRESS_LAST = (NVM_ADDRESS_NODES_LIST + NVM_NODES_LIST_SIZE_BYTES)
 } NVM_address_t;
 
 /*** NVM functions ***/
@@ -8,11 +8,17 @@
 #ifndef __PWR_H__
 #define __PWR_H__
 
+#include "types.h"
+
+/*** PWR structures ***/
+
+typedef uint8_t (*PWR_abort_cb_t)(void);
+
 /*** PWR functions ***/
 
 void PWR_init(void);
 void PWR_enter_sleep_mode(void);
-void PWR_enter_stop_mode(void);
+void PWR_enter_stop_mode(PWR_abort_cb_t abort_callback);
 void PWR_software_reset(void);
 
 #endif /* __PWR_H__ */
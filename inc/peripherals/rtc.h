@@ -10,6 +10,13 @@
 
 #include "types.h"
 
+/*** RTC macros ***/
+
+#define RTC_TIME_OF_DAY_MS_MAX	86400000
+// RTC wake-up timer period.
+// Warning: this value must be lower than the watchdog period = 25s.
+#define RTC_WAKEUP_PERIOD_SECONDS	10
+
 /*** RTC structures ***/
 
 typedef enum {
@@ -28,6 +35,7 @@ void RTC_reset(void);
 RTC_status_t __attribute__((optimize("-O0"))) RTC_init(uint8_t* rtc_use_lse, uint32_t lsi_freq_hz);
 
 uint32_t RTC_get_time_seconds(void);
+uint32_t RTC_get_time_of_day_milliseconds(void);
 
 #define RTC_status_check(error_base) { if (rtc_status != RTC_SUCCESS) { status = error_base + rtc_status; goto errors; }}
 #define RTC_error_check() { ERROR_status_check(rtc_status, RTC_SUCCESS, ERROR_BASE_RTC); }
@@ -0,0 +1,40 @@
+/*
+ * event.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __EVENT_H__
+#define __EVENT_H__
+
+#include "types.h"
+
+/*** EVENT structures ***/
+
+typedef enum {
+	EVENT_TYPE_HMI = 0, // Posted by EXTI interrupts, data is the HMI IRQ flag.
+	EVENT_TYPE_LPTIM1_WAKE_UP, // Posted by LPTIM1 interrupt (notification only, wake-up flag is set in the interrupt).
+	EVENT_TYPE_RTC_WAKE_UP, // Posted by RTC interrupt (notification only, uptime is updated in the interrupt).
+	EVENT_TYPE_AT_BUS_LINE_END, // Posted by LPUART1 interrupt (notification only, line end flag is set in the interrupt), data is the reply buffer index.
+	EVENT_TYPE_LAST
+} EVENT_type_t;
+
+typedef struct {
+	uint8_t type;
+	uint8_t data;
+	uint32_t timestamp_ms; // Time of day when the event was posted.
+} EVENT_t;
+
+typedef void (*EVENT_callback_t)(EVENT_t* event);
+
+/*** EVENT functions ***/
+
+void EVENT_init(void);
+void EVENT_set_callback(EVENT_type_t type, EVENT_callback_t callback);
+void EVENT_post(EVENT_type_t type, uint8_t data);
+void EVENT_dispatch(void);
+uint8_t EVENT_is_pending(void);
+uint32_t EVENT_get_overflow_count(void);
+
+#endif /* __EVENT_H__ */
@@ -16,6 +16,7 @@
 #define MATH_DECIMAL_MAX_LENGTH			10
 #define MATH_HEXADECIMAL_MAX_LENGTH		4
 #define MATH_BYTE_MAX					0xFF
+#define MATH_STATISTICS_SCALE			16 // Fixed-point factor of the running mean (input values must fit on 27 bits).
 
 /*** MATH structures ***/
 
@@ -28,6 +29,21 @@ typedef enum {
 	MATH_ERROR_BASE_LAST = 0x0100
 } MATH_status_t;
 
+typedef struct {
+	uint16_t count;
+	int32_t min;
+	int32_t max;
+	int32_t mean; // Multiplied by MATH_STATISTICS_SCALE.
+	uint64_t m2; // Sum of squared deviations, multiplied by MATH_STATISTICS_SCALE^2.
+} MATH_statistics_t;
+
+typedef struct {
+	int32_t min;
+	int32_t max;
+	int32_t mean;
+	uint32_t standard_deviation;
+} MATH_statistics_result_t;
+
 /*** MATH functions ***/
 
 MATH_status_t MATH_min_u8(uint8_t* data, uint8_t data_length, uint8_t* result);
@@ -50,6 +66,10 @@ MATH_status_t MATH_pow_10(uint8_t power, uint32_t* result);
 MATH_status_t MATH_abs(int32_t x, uint32_t* result);
 MATH_status_t MATH_atan2(int32_t x, int32_t y, uint32_t* alpha);
 
+MATH_status_t MATH_statistics_reset(MATH_statistics_t* statistics);
+MATH_status_t MATH_statistics_add(MATH_statistics_t* statistics, int32_t value);
+MATH_status_t MATH_statistics_get(MATH_statistics_t* statistics, MATH_statistics_result_t* result);
+
 MATH_status_t MATH_two_complement(uint32_t value, uint8_t sign_bit_position, int32_t* result);
 MATH_status_t MATH_one_complement(int32_t value, uint8_t sign_bit_position, uint32_t* result);
 
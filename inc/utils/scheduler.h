@@ -0,0 +1,54 @@
+/*
+ * scheduler.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __SCHEDULER_H__
+#define __SCHEDULER_H__
+
+#include "types.h"
+
+/*** SCHEDULER macros ***/
+
+#define SCHEDULER_TASKS_MAX		4
+
+/*** SCHEDULER structures ***/
+
+typedef enum {
+	SCHEDULER_SUCCESS = 0,
+	SCHEDULER_ERROR_NULL_PARAMETER,
+	SCHEDULER_ERROR_TASKS_COUNT,
+	SCHEDULER_ERROR_TASK_INDEX,
+	SCHEDULER_ERROR_BASE_LAST = 0x0100
+} SCHEDULER_status_t;
+
+typedef uint8_t (*SCHEDULER_ready_callback_t)(void);
+typedef void (*SCHEDULER_run_callback_t)(void);
+
+typedef struct {
+	SCHEDULER_ready_callback_t ready; // Must be short and without side effect (also called at yield points).
+	SCHEDULER_run_callback_t run;
+} SCHEDULER_task_t;
+
+typedef struct {
+	uint32_t run_count;
+	uint32_t wake_count; // Number of stop mode exits.
+	uint32_t active_time_ms; // Run time without stop mode.
+	uint32_t sleep_time_ms; // Stop mode time.
+} SCHEDULER_statistics_t;
+
+/*** SCHEDULER functions ***/
+
+SCHEDULER_status_t SCHEDULER_init(const SCHEDULER_task_t* tasks, uint8_t tasks_count);
+void SCHEDULER_run(void);
+void SCHEDULER_yield(void);
+uint8_t SCHEDULER_is_preemption_requested(void);
+SCHEDULER_status_t SCHEDULER_get_statistics(uint8_t task_index, SCHEDULER_statistics_t* statistics);
+
+#define SCHEDULER_status_check(error_base) { if (scheduler_status != SCHEDULER_SUCCESS) { status = error_base + scheduler_status; goto errors; }}
+#define SCHEDULER_error_check() { ERROR_status_check(scheduler_status, SCHEDULER_SUCCESS, ERROR_BASE_SCHEDULER); }
+#define SCHEDULER_error_check_print() { ERROR_status_check_print(scheduler_status, SCHEDULER_SUCCESS, ERROR_BASE_SCHEDULER); }
+
+#endif /* __SCHEDULER_H__ */
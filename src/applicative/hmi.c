@@ -9,6 +9,7 @@
 
 #include "dinfox.h"
 #include "error.h"
+#include "event.h"
 #include "exti.h"
 #include "font.h"
 #include "gpio.h"
@@ -20,7 +21,7 @@
 #include "mapping.h"
 #include "node.h"
 #include "nvic.h"
-#include "pwr.h"
+#include "scheduler.h"
 #include "sh1106.h"
 #include "string.h"
 #include "types.h"
@@ -29,9 +30,18 @@
 
 #define HMI_DATA_PAGES_DISPLAYED				3
 #define HMI_DATA_PAGES_DEPTH					32
+#define HMI_DATA_PAGES_MASK_ALL					((0b1 << HMI_DATA_PAGES_DISPLAYED) - 1)
+#define HMI_NAVIGATION_MASK_ALL					((0b1 << (2 * HMI_DATA_PAGES_DISPLAYED)) - 1) // Left symbols followed by right symbols.
 
 #define HMI_UNUSED_DURATION_THRESHOLD_SECONDS	5
 
+#define HMI_EVENT_QUEUE_SIZE					8
+
+#define HMI_ENCODER_PERIOD_MS_FAST				30 // Mean period between two detents.
+#define HMI_ENCODER_PERIOD_MS_MEDIUM			80
+#define HMI_ENCODER_ACCELERATION_FAST			4 // Number of lines per detent.
+#define HMI_ENCODER_ACCELERATION_MEDIUM			2
+
 #define HMI_STRING_VALUE_BUFFER_SIZE			16
 
 #define HMI_NAVIGATION_ZONE_WIDTH_CHAR			1
@@ -48,16 +58,23 @@ static const char_t* HMI_TITLE_NODES_LIST = "NODES LIST";
 
 static const char_t* HMI_TEXT_ERROR = "ERROR";
 static const char_t* HMI_TEXT_NA = "N/A";
+static const char_t* HMI_TEXT_DEGRADED = "!";
+static const char_t* HMI_TEXT_LOADING = "...";
 
 static const char_t* HMI_MESSAGE_NODES_SCAN_RUNNING[HMI_DATA_PAGES_DISPLAYED] = {"NODES SCAN", "RUNNING", "..."};
 static const char_t* HMI_MESSAGE_UNSUPPORTED_NODE[HMI_DATA_PAGES_DISPLAYED] = {"UNSUPPORTED", "NODE", STRING_NULL};
 static const char_t* HMI_MESSAGE_NONE_MEASUREMENT[HMI_DATA_PAGES_DISPLAYED] = {"NONE", "MEASUREMENT", "ON THIS NODE"};
-static const char_t* HMI_MESSAGE_READING_DATA[HMI_DATA_PAGES_DISPLAYED] = {"READING DATA", "...", STRING_NULL};
 
 /*** HMI local structures ***/
 
 typedef HMI_status_t (*HMI_irq_callback_t)(void);
 
+typedef struct {
+	HMI_irq_flag_t type;
+	uint8_t count;
+	uint32_t timestamp_ms; // Time of the last occurence.
+} HMI_event_t;
+
 typedef enum {
 	HMI_STATE_INIT = 0,
 	HMI_STATE_IDLE,
@@ -91,8 +108,13 @@ typedef struct {
 	HMI_status_t status;
 	HMI_state_t state;
 	HMI_screen_t screen;
-	volatile uint8_t irq_flags;
 	HMI_irq_callback_t irq_callbacks[HMI_IRQ_LAST];
+	// Input events queue (filled by the event dispatcher, consecutive events of the same type are merged).
+	HMI_event_t events[HMI_EVENT_QUEUE_SIZE];
+	uint8_t events_write_idx;
+	uint8_t events_read_idx;
+	HMI_event_t event; // Event being processed.
+	uint32_t encoder_previous_timestamp_ms;
 	// Screen.
 	char_t text[HMI_DATA_ZONE_WIDTH_CHAR + 1];
 	uint8_t text_width;
@@ -101,8 +123,13 @@ typedef struct {
 	uint8_t data_index;
 	uint8_t data_offset_index;
 	uint8_t pointer_index;
+	uint8_t data_loading;
+	// Displayed pages and navigation symbols which have to be printed again.
+	uint8_t data_dirty_mask;
+	uint8_t data_printed_offset_index;
 	char_t navigation_left[HMI_DATA_PAGES_DISPLAYED][HMI_NAVIGATION_ZONE_WIDTH_CHAR + 1];
 	char_t navigation_right[HMI_DATA_PAGES_DISPLAYED][HMI_NAVIGATION_ZONE_WIDTH_CHAR + 1];
+	uint8_t navigation_dirty_mask;
 	SH1106_horizontal_line_t sh1106_line;
 	// Current node.
 	NODE_t node;
@@ -115,6 +142,90 @@ static const uint8_t HMI_DATA_PAGE_ADDRESS[HMI_DATA_PAGES_DISPLAYED] = {HMI_PAGE
 
 /*** HMI local functions ***/
 
+/* HMI EVENT CALLBACK.
+ * @param event:	Pointer to the event posted by EXTI interrupts.
+ * @return:			None.
+ */
+static void _HMI_event_callback(EVENT_t* event) {
+	// Local variables.
+	uint8_t last_idx = ((hmi_ctx.events_write_idx + HMI_EVENT_QUEUE_SIZE - 1) % HMI_EVENT_QUEUE_SIZE);
+	uint8_t next_write_idx = ((hmi_ctx.events_write_idx + 1) % HMI_EVENT_QUEUE_SIZE);
+	// Check parameter.
+	if ((event -> data) >= HMI_IRQ_LAST) return;
+	// Merge with the last queued event if it has the same type.
+	if ((hmi_ctx.events_read_idx != hmi_ctx.events_write_idx) && (hmi_ctx.events[last_idx].type == (event -> data))) {
+		if (hmi_ctx.events[last_idx].count < 0xFF) hmi_ctx.events[last_idx].count++;
+		hmi_ctx.events[last_idx].timestamp_ms = (event -> timestamp_ms);
+		return;
+	}
+	// Drop event if queue is full.
+	if (next_write_idx == hmi_ctx.events_read_idx) return;
+	hmi_ctx.events[hmi_ctx.events_write_idx].type = (event -> data);
+	hmi_ctx.events[hmi_ctx.events_write_idx].count = 1;
+	hmi_ctx.events[hmi_ctx.events_write_idx].timestamp_ms = (event -> timestamp_ms);
+	hmi_ctx.events_write_idx = next_write_idx;
+}
+
+/* CHECK IF AN EVENT TYPE IS PRESENT IN THE QUEUE.
+ * @param type:	Event type to search.
+ * @return:		1 if at least one event of this type is pending, 0 otherwise.
+ */
+static uint8_t _HMI_is_event_pending(HMI_irq_flag_t type) {
+	// Local variables.
+	uint8_t idx = hmi_ctx.events_read_idx;
+	// Queue loop.
+	while (idx != hmi_ctx.events_write_idx) {
+		if (hmi_ctx.events[idx].type == type) return 1;
+		idx = ((idx + 1) % HMI_EVENT_QUEUE_SIZE);
+	}
+	return 0;
+}
+
+/* READ OLDEST EVENT OF THE QUEUE.
+ * @param:	None.
+ * @return:	1 if an event was read in the context, 0 if the queue is empty.
+ */
+static uint8_t _HMI_read_event(void) {
+	// Check queue.
+	if (hmi_ctx.events_read_idx == hmi_ctx.events_write_idx) return 0;
+	// Copy event.
+	hmi_ctx.event = hmi_ctx.events[hmi_ctx.events_read_idx];
+	hmi_ctx.events_read_idx = ((hmi_ctx.events_read_idx + 1) % HMI_EVENT_QUEUE_SIZE);
+	return 1;
+}
+
+/* COMPUTE NUMBER OF LINES TO MOVE FOR THE CURRENT ENCODER EVENT.
+ * @param:	None.
+ * @return:	Number of lines (detents count multiplied by the acceleration factor).
+ */
+static uint8_t _HMI_get_encoder_steps(void) {
+	// Local variables.
+	uint32_t elapsed_ms = 0;
+	uint32_t period_ms = 0;
+	uint32_t steps = hmi_ctx.event.count;
+	// Compute mean period between detents since the previous encoder event.
+	if (hmi_ctx.event.timestamp_ms >= hmi_ctx.encoder_previous_timestamp_ms) {
+		elapsed_ms = (hmi_ctx.event.timestamp_ms - hmi_ctx.encoder_previous_timestamp_ms);
+	}
+	else {
+		elapsed_ms = (hmi_ctx.event.timestamp_ms + RTC_TIME_OF_DAY_MS_MAX - hmi_ctx.encoder_previous_timestamp_ms);
+	}
+	period_ms = (elapsed_ms / (hmi_ctx.event.count));
+	hmi_ctx.encoder_previous_timestamp_ms = hmi_ctx.event.timestamp_ms;
+	// Apply acceleration.
+	if (period_ms < HMI_ENCODER_PERIOD_MS_FAST) {
+		steps *= HMI_ENCODER_ACCELERATION_FAST;
+	}
+	else if (period_ms < HMI_ENCODER_PERIOD_MS_MEDIUM) {
+		steps *= HMI_ENCODER_ACCELERATION_MEDIUM;
+	}
+	// Moving more than the list depth is useless.
+	if (steps > HMI_DATA_PAGES_DEPTH) {
+		steps = HMI_DATA_PAGES_DEPTH;
+	}
+	return ((uint8_t) steps);
+}
+
 /* FLUSH TEXT BUFFER.
  * @param:	None.
  * @return:	None.
@@ -143,6 +254,31 @@ static void _HMI_data_flush(void) {
 		}
 	}
 	hmi_ctx.data_depth = 0;
+	hmi_ctx.data_dirty_mask = HMI_DATA_PAGES_MASK_ALL;
+}
+
+/* MARK A DATA LINE AS MODIFIED.
+ * @param data_index:	Index of the modified line.
+ * @return:				None.
+ */
+static void _HMI_set_data_dirty(uint8_t data_index) {
+	// Check if line is displayed.
+	if ((data_index >= hmi_ctx.data_offset_index) && (data_index < (hmi_ctx.data_offset_index + HMI_DATA_PAGES_DISPLAYED))) {
+		hmi_ctx.data_dirty_mask |= (0b1 << (data_index - hmi_ctx.data_offset_index));
+	}
+}
+
+/* UPDATE A NAVIGATION SYMBOL.
+ * @param symbol:		Navigation symbol to update.
+ * @param new_symbol:	New symbol.
+ * @param dirty_bit:	Bit of the symbol in the navigation dirty mask.
+ * @return:				None.
+ */
+static void _HMI_set_navigation_symbol(char_t* symbol, char_t new_symbol, uint8_t dirty_bit) {
+	// Check if symbol changes.
+	if ((*symbol) == new_symbol) return;
+	(*symbol) = new_symbol;
+	hmi_ctx.navigation_dirty_mask |= (0b1 << dirty_bit);
 }
 
 /* PRINT TITLE ZONE ON SCREEN.
@@ -195,16 +331,21 @@ static HMI_status_t _HMI_print_navigation(void) {
 		// Common
 		sh1106_text.page = HMI_DATA_PAGE_ADDRESS[idx];
 		// Left.
-		sh1106_text.str = (char_t*) hmi_ctx.navigation_left[idx];
-		sh1106_text.justification = STRING_JUSTIFICATION_LEFT;
-		sh1106_status = SH1106_print_text(&sh1106_text);
-		SH1106_status_check(HMI_ERROR_BASE_SH1106);
+		if ((hmi_ctx.navigation_dirty_mask & (0b1 << idx)) != 0) {
+			sh1106_text.str = (char_t*) hmi_ctx.navigation_left[idx];
+			sh1106_text.justification = STRING_JUSTIFICATION_LEFT;
+			sh1106_status = SH1106_print_text(&sh1106_text);
+			SH1106_status_check(HMI_ERROR_BASE_SH1106);
+		}
 		// Right.
-		sh1106_text.str = (char_t*) hmi_ctx.navigation_right[idx];
-		sh1106_text.justification = STRING_JUSTIFICATION_RIGHT;
-		sh1106_status = SH1106_print_text(&sh1106_text);
-		SH1106_status_check(HMI_ERROR_BASE_SH1106);
+		if ((hmi_ctx.navigation_dirty_mask & (0b1 << (idx + HMI_DATA_PAGES_DISPLAYED))) != 0) {
+			sh1106_text.str = (char_t*) hmi_ctx.navigation_right[idx];
+			sh1106_text.justification = STRING_JUSTIFICATION_RIGHT;
+			sh1106_status = SH1106_print_text(&sh1106_text);
+			SH1106_status_check(HMI_ERROR_BASE_SH1106);
+		}
 	}
+	hmi_ctx.navigation_dirty_mask = 0;
 errors:
 	return status;
 }
@@ -224,14 +365,22 @@ static HMI_status_t _HMI_print_data(void) {
 	sh1106_text.contrast = SH1106_TEXT_CONTRAST_NORMAL;
 	sh1106_text.vertical_position = SH1106_TEXT_VERTICAL_POSITION_TOP;
 	sh1106_text.flush_width_pixels = HMI_DATA_ZONE_WIDTH_PIXELS;
+	// All displayed lines change when the list is scrolled.
+	if (hmi_ctx.data_offset_index != hmi_ctx.data_printed_offset_index) {
+		hmi_ctx.data_dirty_mask = HMI_DATA_PAGES_MASK_ALL;
+		hmi_ctx.data_printed_offset_index = hmi_ctx.data_offset_index;
+	}
 	// Data pages loop.
 	for (idx=0 ; idx<HMI_DATA_PAGES_DISPLAYED ; idx++) {
+		// Skip unchanged lines.
+		if ((hmi_ctx.data_dirty_mask & (0b1 << idx)) == 0) continue;
 		// Set page and string.
 		sh1106_text.page = HMI_DATA_PAGE_ADDRESS[idx];
 		sh1106_text.str = (char_t*) hmi_ctx.data[hmi_ctx.data_offset_index + idx];
 		sh1106_status = SH1106_print_text(&sh1106_text);
 		SH1106_status_check(HMI_ERROR_BASE_SH1106);
 	}
+	hmi_ctx.data_dirty_mask = 0;
 errors:
 	return status;
 }
@@ -312,16 +461,16 @@ static HMI_status_t _HMI_update_and_print_navigation(HMI_screen_t screen) {
 	case HMI_SCREEN_NODES_LIST:
 	case HMI_SCREEN_NODE_DATA:
 		for (idx=0 ; idx<HMI_DATA_PAGES_DISPLAYED ; idx++) {
-			hmi_ctx.navigation_left[idx][0] = ((hmi_ctx.pointer_index == idx) && (hmi_ctx.data_depth != 0)) ? HMI_SYMBOL_SELECT : STRING_CHAR_SPACE;
+			_HMI_set_navigation_symbol(&(hmi_ctx.navigation_left[idx][0]), (((hmi_ctx.pointer_index == idx) && (hmi_ctx.data_depth != 0)) ? HMI_SYMBOL_SELECT : STRING_CHAR_SPACE), idx);
 			switch (idx) {
 			case 0:
-				hmi_ctx.navigation_right[idx][0] = (hmi_ctx.data_offset_index > 0) ? HMI_SYMBOL_TOP : STRING_CHAR_SPACE;
+				_HMI_set_navigation_symbol(&(hmi_ctx.navigation_right[idx][0]), ((hmi_ctx.data_offset_index > 0) ? HMI_SYMBOL_TOP : STRING_CHAR_SPACE), (idx + HMI_DATA_PAGES_DISPLAYED));
 				break;
 			case (HMI_DATA_PAGES_DISPLAYED - 1):
-				hmi_ctx.navigation_right[idx][0] = (hmi_ctx.data_offset_index < (hmi_ctx.data_depth - HMI_DATA_PAGES_DISPLAYED)) ? HMI_SYMBOL_BOTTOM : STRING_CHAR_SPACE;
+				_HMI_set_navigation_symbol(&(hmi_ctx.navigation_right[idx][0]), ((hmi_ctx.data_offset_index < (hmi_ctx.data_depth - HMI_DATA_PAGES_DISPLAYED)) ? HMI_SYMBOL_BOTTOM : STRING_CHAR_SPACE), (idx + HMI_DATA_PAGES_DISPLAYED));
 				break;
 			default:
-				hmi_ctx.navigation_right[idx][0] = STRING_CHAR_SPACE;
+				_HMI_set_navigation_symbol(&(hmi_ctx.navigation_right[idx][0]), STRING_CHAR_SPACE, (idx + HMI_DATA_PAGES_DISPLAYED));
 				break;
 			}
 		}
@@ -329,8 +478,8 @@ static HMI_status_t _HMI_update_and_print_navigation(HMI_screen_t screen) {
 	default:
 		// Disable navigation symbols in all other cases.
 		for (idx=0 ; idx<HMI_DATA_PAGES_DISPLAYED ; idx++) {
-			hmi_ctx.navigation_left[idx][0] = STRING_CHAR_SPACE;
-			hmi_ctx.navigation_right[idx][0] = STRING_CHAR_SPACE;
+			_HMI_set_navigation_symbol(&(hmi_ctx.navigation_left[idx][0]), STRING_CHAR_SPACE, idx);
+			_HMI_set_navigation_symbol(&(hmi_ctx.navigation_right[idx][0]), STRING_CHAR_SPACE, (idx + HMI_DATA_PAGES_DISPLAYED));
 		}
 		break;
 	}
@@ -338,11 +487,11 @@ static HMI_status_t _HMI_update_and_print_navigation(HMI_screen_t screen) {
 	return status;
 }
 
-/* UPDATE VALUE ON CURRENT STRING DATA INDEX.
- * @param:			None.
- * @return status:	Function execution status.
+/* COPY NODE STRING DATA IN DATA BUFFER.
+ * @param data_index:	Node string data index.
+ * @return status:		Function execution status.
  */
-static HMI_status_t _HMI_update_data(void) {
+static HMI_status_t _HMI_copy_node_data(uint8_t data_index) {
 	// Local variables.
 	HMI_status_t status = HMI_SUCCESS;
 	NODE_status_t node_status = NODE_SUCCESS;
@@ -350,10 +499,52 @@ static HMI_status_t _HMI_update_data(void) {
 	STRING_copy_t string_copy;
 	char_t* text_ptr_1 = NULL;
 	char_t* text_ptr_2 = NULL;
+	// Check index.
+	if (data_index >= HMI_DATA_PAGES_DEPTH) {
+		status = HMI_ERROR_DATA_DEPTH_OVERFLOW;
+		goto errors;
+	}
 	// Common string copy parameter.
 	string_copy.flush_char = STRING_CHAR_SPACE;
-	string_copy.destination = (char_t*) hmi_ctx.data[hmi_ctx.data_index];
+	string_copy.destination = (char_t*) hmi_ctx.data[data_index];
 	string_copy.destination_size = HMI_DATA_ZONE_WIDTH_CHAR;
+	_HMI_set_data_dirty(data_index);
+	// Print temporary text while data is being read.
+	if (NODE_get_data_pending_flag(data_index) != 0) {
+		string_copy.source = (char_t*) HMI_TEXT_LOADING;
+		string_copy.justification = STRING_JUSTIFICATION_LEFT;
+		string_copy.flush_flag = 1;
+		string_status = STRING_copy(&string_copy);
+		STRING_status_check(HMI_ERROR_BASE_STRING);
+		goto errors;
+	}
+	// Read data.
+	node_status = NODE_read_string_data(&hmi_ctx.node, data_index, &text_ptr_1, &text_ptr_2);
+	NODE_status_check(HMI_ERROR_BASE_NODE);
+	// Print data name.
+	string_copy.source = text_ptr_1;
+	string_copy.justification = STRING_JUSTIFICATION_LEFT;
+	string_copy.flush_flag = 1;
+	string_status = STRING_copy(&string_copy);
+	STRING_status_check(HMI_ERROR_BASE_STRING);
+	// Print data value.
+	string_copy.source = text_ptr_2;
+	string_copy.justification = STRING_JUSTIFICATION_RIGHT;
+	string_copy.flush_flag = 0;
+	string_status = STRING_copy(&string_copy);
+	STRING_status_check(HMI_ERROR_BASE_STRING);
+errors:
+	return status;
+}
+
+/* UPDATE VALUE ON CURRENT STRING DATA INDEX.
+ * @param:			None.
+ * @return status:	Function execution status.
+ */
+static HMI_status_t _HMI_update_data(void) {
+	// Local variables.
+	HMI_status_t status = HMI_SUCCESS;
+	NODE_status_t node_status = NODE_SUCCESS;
 	// Check screen.
 	if (hmi_ctx.screen != HMI_SCREEN_NODE_DATA) {
 		status = HMI_ERROR_SCREEN;
@@ -368,28 +559,61 @@ static HMI_status_t _HMI_update_data(void) {
 		// Do not update data.
 		goto errors;
 	}
-	// Read data.
-	node_status = NODE_read_string_data(&hmi_ctx.node, hmi_ctx.data_index, &text_ptr_1, &text_ptr_2);
-	// Check status and pointers.
-	if (node_status != NODE_ERROR_NOT_SUPPORTED) {
-		NODE_status_check(HMI_ERROR_BASE_NODE);
+	// Update line.
+	status = _HMI_copy_node_data(hmi_ctx.data_index);
+errors:
+	return status;
+}
+
+/* LOAD NEXT PENDING NODE DATA (VISIBLE LINES FIRST).
+ * @param:			None.
+ * @return status:	Function execution status.
+ */
+static HMI_status_t _HMI_load_next_data(void) {
+	// Local variables.
+	HMI_status_t status = HMI_SUCCESS;
+	NODE_status_t node_status = NODE_SUCCESS;
+	SH1106_status_t sh1106_status = SH1106_SUCCESS;
+	uint8_t data_index = hmi_ctx.data_depth;
+	uint8_t idx = 0;
+	// Check screen.
+	if (hmi_ctx.screen != HMI_SCREEN_NODE_DATA) {
+		hmi_ctx.data_loading = 0;
+		goto errors;
 	}
-	else {
-		// Do not update data.
+	// Search pending line in the displayed window.
+	for (idx=0 ; idx<HMI_DATA_PAGES_DISPLAYED ; idx++) {
+		if (((hmi_ctx.data_offset_index + idx) < hmi_ctx.data_depth) && (NODE_get_data_pending_flag(hmi_ctx.data_offset_index + idx) != 0)) {
+			data_index = (hmi_ctx.data_offset_index + idx);
+			break;
+		}
+	}
+	// Then in the whole list.
+	if (data_index >= hmi_ctx.data_depth) {
+		for (idx=0 ; idx<hmi_ctx.data_depth ; idx++) {
+			if (NODE_get_data_pending_flag(idx) != 0) {
+				data_index = idx;
+				break;
+			}
+		}
+	}
+	// Check if all lines are loaded.
+	if (data_index >= hmi_ctx.data_depth) {
+		hmi_ctx.data_loading = 0;
 		goto errors;
 	}
-	// Update name.
-	string_copy.source = text_ptr_1;
-	string_copy.justification = STRING_JUSTIFICATION_LEFT;
-	string_copy.flush_flag = 1;
-	string_status = STRING_copy(&string_copy);
-	STRING_status_check(HMI_ERROR_BASE_STRING);
-	// Update value.
-	string_copy.source = text_ptr_2;
-	string_copy.justification = STRING_JUSTIFICATION_RIGHT;
-	string_copy.flush_flag = 0;
-	string_status = STRING_copy(&string_copy);
-	STRING_status_check(HMI_ERROR_BASE_STRING);
+	// Read data.
+	node_status = NODE_update_pending_data(&hmi_ctx.node, data_index);
+	NODE_status_check(HMI_ERROR_BASE_NODE);
+	status = _HMI_copy_node_data(data_index);
+	if (status != HMI_SUCCESS) goto errors;
+	// Print line immediately if it is displayed.
+	if ((data_index >= hmi_ctx.data_offset_index) && (data_index < (hmi_ctx.data_offset_index + HMI_DATA_PAGES_DISPLAYED))) {
+		status = _HMI_print_data();
+		if (status != HMI_SUCCESS) goto errors;
+		sh1106_status = SH1106_flush();
+		SH1106_status_check(HMI_ERROR_BASE_SH1106);
+	}
 errors:
 	return status;
 }
@@ -405,12 +629,12 @@ static HMI_status_t _HMI_update_all_data(HMI_screen_t screen) {
 	STRING_status_t string_status = STRING_SUCCESS;
 	STRING_copy_t string_copy;
 	char_t* text_ptr_1 = NULL;
-	char_t* text_ptr_2 = NULL;
 	uint8_t idx = 0;
 	uint8_t last_string_data_index = 0;
 	// Flush buffers.
 	_HMI_data_flush();
 	_HMI_text_flush();
+	hmi_ctx.data_loading = 0;
 	// Common parameters.
 	string_copy.flush_char = STRING_CHAR_SPACE;
 	string_copy.destination_size = HMI_DATA_ZONE_WIDTH_CHAR;
@@ -445,8 +669,12 @@ static HMI_status_t _HMI_update_all_data(HMI_screen_t screen) {
 			string_copy.flush_flag = 1;
 			string_status = STRING_copy(&string_copy);
 			STRING_status_check(HMI_ERROR_BASE_STRING);
-			// Print node address.
+			// Print node address, marked if the node does not answer anymore.
 			_HMI_text_flush();
+			if (NODE_get_degraded_flag(&hmi_ctx.node) != 0) {
+				string_status = STRING_append_string(hmi_ctx.text, HMI_DATA_ZONE_WIDTH_CHAR, (char_t*) HMI_TEXT_DEGRADED, &hmi_ctx.text_width);
+				STRING_status_check(HMI_ERROR_BASE_STRING);
+			}
 			status = STRING_append_value(hmi_ctx.text, HMI_DATA_ZONE_WIDTH_CHAR, NODES_LIST.list[idx].address, STRING_FORMAT_HEXADECIMAL, 1, &hmi_ctx.text_width);
 			STRING_status_check(HMI_ERROR_BASE_STRING);
 			string_copy.source = (char_t*) hmi_ctx.text;
@@ -470,22 +698,8 @@ static HMI_status_t _HMI_update_all_data(HMI_screen_t screen) {
 		}
 		break;
 	case HMI_SCREEN_NODE_DATA:
-		// Print temporary screen during data reading.
-		string_copy.justification = STRING_JUSTIFICATION_CENTER;
-		string_copy.flush_flag = 1;
-		// Lines loop.
-		for (idx=0 ; idx<HMI_DATA_PAGES_DISPLAYED ; idx++) {
-			string_copy.source = (char_t*) HMI_MESSAGE_READING_DATA[idx];
-			string_copy.destination = (char_t*) hmi_ctx.data[hmi_ctx.data_offset_index + idx];
-			string_status = STRING_copy(&string_copy);
-			STRING_status_check(HMI_ERROR_BASE_STRING);
-		}
-		status = _HMI_print_data();
-		if (status != HMI_SUCCESS) goto errors;
-		// Flush buffers.
-		_HMI_data_flush();
-		// Update all node data.
-		node_status = NODE_update_all_data(&hmi_ctx.node);
+		// Start node data update (lines are then read one by one in background).
+		node_status = NODE_start_update_all_data(&hmi_ctx.node);
 		switch (node_status) {
 		case NODE_SUCCESS:
 			// Go to next step.
@@ -524,33 +738,14 @@ static HMI_status_t _HMI_update_all_data(HMI_screen_t screen) {
 			}
 			goto errors;
 		}
-		// Data lines loop.
+		// Data lines loop (pending lines are printed as temporary text).
 		for (idx=0 ; idx<last_string_data_index ; idx++) {
-			// Check index.
-			if (idx >= HMI_DATA_PAGES_DEPTH) {
-				status = HMI_ERROR_DATA_DEPTH_OVERFLOW;
-				goto errors;
-			}
-			// Read data.
-			node_status = NODE_read_string_data(&hmi_ctx.node, idx, &text_ptr_1, &text_ptr_2);
-			NODE_status_check(HMI_ERROR_BASE_NODE);
-			// Update pointer.
-			string_copy.destination = (char_t*) hmi_ctx.data[idx];
-			// Print data name.
-			string_copy.source = text_ptr_1;
-			string_copy.justification = STRING_JUSTIFICATION_LEFT;
-			string_copy.flush_flag = 1;
-			string_status = STRING_copy(&string_copy);
-			STRING_status_check(HMI_ERROR_BASE_STRING);
-			// Print data value.
-			string_copy.source = text_ptr_2;
-			string_copy.justification = STRING_JUSTIFICATION_RIGHT;
-			string_copy.flush_flag = 0;
-			string_status = STRING_copy(&string_copy);
-			STRING_status_check(HMI_ERROR_BASE_STRING);
+			status = _HMI_copy_node_data(idx);
+			if (status != HMI_SUCCESS) goto errors;
 		}
 		// Update depth.
 		hmi_ctx.data_depth = idx;
+		hmi_ctx.data_loading = 1;
 		break;
 	case HMI_SCREEN_ERROR:
 		// Common parameters.
@@ -593,9 +788,10 @@ static void _HMI_reset_navigation(void) {
  * @return:	None.
  */
 static void _HMI_enable_irq(void) {
-	// Clear flags.
+	// Clear flags and flush events queue.
 	EXTI_clear_all_flags();
-	hmi_ctx.irq_flags = 0;
+	EVENT_dispatch();
+	hmi_ctx.events_read_idx = hmi_ctx.events_write_idx;
 	// Enable interrupts.
 	NVIC_enable_interrupt(NVIC_INTERRUPT_EXTI_0_1);
 	NVIC_enable_interrupt(NVIC_INTERRUPT_EXTI_2_3);
@@ -620,11 +816,13 @@ static void _HMI_disable_irq(void) {
 static HMI_status_t _HMI_update(HMI_screen_t screen, uint8_t update_all_data, uint8_t update_navigation) {
 	// Local variables.
 	HMI_status_t status = HMI_SUCCESS;
-	// Disable interrupts during update.
-	_HMI_disable_irq();
+	SH1106_status_t sh1106_status = SH1106_SUCCESS;
 	// Check if screen has changed.
 	if (hmi_ctx.screen != screen) {
 		_HMI_reset_navigation();
+		// Print all lines and navigation symbols.
+		hmi_ctx.data_dirty_mask = HMI_DATA_PAGES_MASK_ALL;
+		hmi_ctx.navigation_dirty_mask = HMI_NAVIGATION_MASK_ALL;
 		// Update  and print title.
 		status = _HMI_update_and_print_title(screen);
 		if (status != HMI_SUCCESS) goto errors;
@@ -642,10 +840,12 @@ static HMI_status_t _HMI_update(HMI_screen_t screen, uint8_t update_all_data, ui
 		status = _HMI_update_and_print_navigation(screen);
 		if (status != HMI_SUCCESS) goto errors;
 	}
+	// Send all changes to the screen at once.
+	sh1106_status = SH1106_flush();
+	SH1106_status_check(HMI_ERROR_BASE_SH1106);
 	// Update context.
 	hmi_ctx.screen = screen;
 errors:
-	_HMI_enable_irq();
 	return status;
 }
 
@@ -679,21 +879,26 @@ static HMI_status_t _HMI_irq_callback_encoder_switch(void) {
 static HMI_status_t _HMI_irq_callback_encoder_forward(void) {
 	// Local variables.
 	HMI_status_t status = HMI_SUCCESS;
-	// Increment data select index.
-	if (hmi_ctx.data_index < (hmi_ctx.data_depth - 1)) {
-		hmi_ctx.data_index++;
-	}
-	if (hmi_ctx.pointer_index < (HMI_DATA_PAGES_DISPLAYED - 1)) {
-		hmi_ctx.pointer_index++;
-	}
-	else {
-		if ((hmi_ctx.data_depth - HMI_DATA_PAGES_DISPLAYED) > 0) {
-			if (hmi_ctx.data_offset_index < (hmi_ctx.data_depth - HMI_DATA_PAGES_DISPLAYED)) {
-				hmi_ctx.data_offset_index++;
+	uint8_t steps = _HMI_get_encoder_steps();
+	uint8_t idx = 0;
+	// Steps loop.
+	for (idx=0 ; idx<steps ; idx++) {
+		// Increment data select index.
+		if (hmi_ctx.data_index < (hmi_ctx.data_depth - 1)) {
+			hmi_ctx.data_index++;
+		}
+		if (hmi_ctx.pointer_index < (HMI_DATA_PAGES_DISPLAYED - 1)) {
+			hmi_ctx.pointer_index++;
+		}
+		else {
+			if ((hmi_ctx.data_depth - HMI_DATA_PAGES_DISPLAYED) > 0) {
+				if (hmi_ctx.data_offset_index < (hmi_ctx.data_depth - HMI_DATA_PAGES_DISPLAYED)) {
+					hmi_ctx.data_offset_index++;
+				}
 			}
 		}
 	}
-	// Update display.
+	// Update display once.
 	status = _HMI_update(hmi_ctx.screen, 0, 1);
 	return status;
 }
@@ -705,19 +910,24 @@ static HMI_status_t _HMI_irq_callback_encoder_forward(void) {
 static HMI_status_t _HMI_irq_callback_encoder_backward(void) {
 	// Local variables.
 	HMI_status_t status = HMI_SUCCESS;
-	// Increment data select index.
-	if (hmi_ctx.data_index > 0) {
-		hmi_ctx.data_index--;
-	}
-	if (hmi_ctx.pointer_index > 0) {
-		hmi_ctx.pointer_index--;
-	}
-	else {
-		if (hmi_ctx.data_offset_index > 0) {
-			hmi_ctx.data_offset_index--;
+	uint8_t steps = _HMI_get_encoder_steps();
+	uint8_t idx = 0;
+	// Steps loop.
+	for (idx=0 ; idx<steps ; idx++) {
+		// Decrement data select index.
+		if (hmi_ctx.data_index > 0) {
+			hmi_ctx.data_index--;
+		}
+		if (hmi_ctx.pointer_index > 0) {
+			hmi_ctx.pointer_index--;
+		}
+		else {
+			if (hmi_ctx.data_offset_index > 0) {
+				hmi_ctx.data_offset_index--;
+			}
 		}
 	}
-	// Update display.
+	// Update display once.
 	status = _HMI_update(hmi_ctx.screen, 0, 1);
 	return status;
 }
@@ -833,7 +1043,6 @@ static HMI_status_t _HMI_irq_callback_bp3(void) {
  */
 static HMI_status_t _HMI_state_machine(void) {
 	// Local variables.
-	uint8_t idx = 0;
 	HMI_status_t status = HMI_SUCCESS;
 	I2C_status_t i2c1_status = I2C_SUCCESS;
 	LPTIM_status_t lptim1_status = LPTIM_SUCCESS;
@@ -850,6 +1059,8 @@ static HMI_status_t _HMI_state_machine(void) {
 		// Display DINFox logo.
 		sh1106_status = SH1106_print_image(DINFOX_LOGO);
 		SH1106_status_check(HMI_ERROR_BASE_SH1106);
+		sh1106_status = SH1106_flush();
+		SH1106_status_check(HMI_ERROR_BASE_SH1106);
 		lptim1_status = LPTIM1_delay_milliseconds(1000, LPTIM_DELAY_MODE_STOP);
 		LPTIM1_status_check(HMI_ERROR_BASE_LPTIM);
 		SH1106_clear();
@@ -862,16 +1073,17 @@ static HMI_status_t _HMI_state_machine(void) {
 		hmi_ctx.state = HMI_STATE_IDLE;
 		break;
 	case HMI_STATE_IDLE:
-		// Process IRQ flags.
-		for (idx=0 ; idx<HMI_IRQ_LAST ; idx++) {
-			// Check flag.
-			if ((hmi_ctx.irq_flags & (0b1 << idx)) != 0) {
-				// Execute callback and clear flag.
-				status = hmi_ctx.irq_callbacks[idx]();
-				hmi_ctx.irq_flags &= ~(0b1 << idx);
-				// Exit in case of error.
-				if (status != HMI_SUCCESS) goto errors;
-			}
+		// Process events (detents received during the previous update are handled at once).
+		EVENT_dispatch();
+		while (_HMI_read_event() != 0) {
+			status = hmi_ctx.irq_callbacks[hmi_ctx.event.type]();
+			// Exit in case of error.
+			if (status != HMI_SUCCESS) goto errors;
+		}
+		// Read next node data between user actions.
+		if (hmi_ctx.data_loading != 0) {
+			status = _HMI_load_next_data();
+			if (status != HMI_SUCCESS) goto errors;
 		}
 		break;
 	case HMI_STATE_UNUSED:
@@ -894,6 +1106,13 @@ void HMI_init(void) {
 	// Init context.
 	hmi_ctx.node.address = 0xFF;
 	hmi_ctx.node.board_id = DINFOX_BOARD_ID_ERROR;
+	hmi_ctx.data_loading = 0;
+	hmi_ctx.data_printed_offset_index = 0;
+	hmi_ctx.events_write_idx = 0;
+	hmi_ctx.events_read_idx = 0;
+	hmi_ctx.encoder_previous_timestamp_ms = 0;
+	EVENT_set_callback(EVENT_TYPE_HMI, &_HMI_event_callback);
+	hmi_ctx.navigation_dirty_mask = HMI_NAVIGATION_MASK_ALL;
 	_HMI_reset_navigation();
 	// Init callbacks.
 	hmi_ctx.irq_callbacks[HMI_IRQ_ENCODER_SWITCH] = &_HMI_irq_callback_encoder_switch;
@@ -943,7 +1162,7 @@ HMI_status_t HMI_task(void) {
 	LPTIM_status_t lptim1_status = LPTIM_SUCCESS;
 	// Init context.
 	hmi_ctx.screen = HMI_SCREEN_OFF;
-	hmi_ctx.state = ((hmi_ctx.irq_flags & (0b1 << HMI_IRQ_ENCODER_SWITCH)) != 0) ? HMI_STATE_INIT : HMI_STATE_UNUSED;
+	hmi_ctx.state = (_HMI_is_event_pending(HMI_IRQ_ENCODER_SWITCH) != 0) ? HMI_STATE_INIT : HMI_STATE_UNUSED;
 	// Turn bus interface on.
 	lpuart1_status = LPUART1_power_on();
 	LPUART1_status_check(HMI_ERROR_BASE_LPUART);
@@ -960,16 +1179,21 @@ HMI_status_t HMI_task(void) {
 			LPTIM1_status_check(HMI_ERROR_BASE_LPTIM);
 			goto errors;
 		}
+		// Do not sleep while node data is loading.
+		if (hmi_ctx.data_loading != 0) {
+			IWDG_reload();
+			continue;
+		}
 		// Start auto power-off timer.
 		lptim1_status = LPTIM1_start(HMI_UNUSED_DURATION_THRESHOLD_SECONDS * 1000);
 		LPTIM1_status_check(HMI_ERROR_BASE_LPTIM);
 		// Enter stop mode.
-		PWR_enter_stop_mode();
+		SCHEDULER_yield();
 		// Wake-up.
 		IWDG_reload();
 		LPTIM1_stop();
 		// Check LPTIM flag.
-		if ((LPTIM1_get_wake_up_flag() != 0) && (hmi_ctx.irq_flags == 0)) {
+		if ((LPTIM1_get_wake_up_flag() != 0) && (hmi_ctx.events_read_idx == hmi_ctx.events_write_idx)) {
 			// Auto power-off.
 			hmi_ctx.state = HMI_STATE_UNUSED;
 		}
@@ -984,11 +1208,10 @@ errors:
 	return status;
 }
 
-/* SET IRQ FLAG (CALLED BY EXTI INTERRUPT).
- * @param irq_flag:	IRQ flag to set.
- * @return:			None.
+/* CHECK IF HMI ACTIVATION HAS BEEN REQUESTED (ENCODER SWITCH EVENT).
+ * @param:	None.
+ * @return:	1 if the encoder switch has been pressed, 0 otherwise.
  */
-void HMI_set_irq_flag(HMI_irq_flag_t irq_flag) {
-	// Set local flag.
-	hmi_ctx.irq_flags |= (0b1 << irq_flag);
+uint8_t HMI_get_activation_flag(void) {
+	return _HMI_is_event_pending(HMI_IRQ_ENCODER_SWITCH);
 }
@@ -24,7 +24,11 @@
 #define SH1106_OFFSET_WIDTH_PIXELS		((SH1106_RAM_WIDTH_PIXELS - SH1106_SCREEN_WIDTH_PIXELS) / 2)
 #define SH1106_OFFSET_HEIGHT_PIXELS		((SH1106_RAM_HEIGHT_PIXELS - SH1106_SCREEN_HEIGHT_PIXELS) / 2)
 
-#define SH1106_I2C_BUFFER_SIZE_BYTES	256
+#define SH1106_I2C_BUFFER_SIZE_BYTES	8 // Commands and their control byte.
+
+#define SH1106_PAGE_HEADER_SIZE_BYTES	9 // Address commands and RAM control byte.
+#define SH1106_PAGE_BUFFER_SIZE_BYTES	(SH1106_PAGE_HEADER_SIZE_BYTES + SH1106_SCREEN_WIDTH_PIXELS) // One full page and its header.
+#define SH1106_PAGE_BUFFER_NUMBER		2 // Ping-pong buffers.
 
 /*** SH1106 local structures ***/
 
@@ -36,8 +40,15 @@ typedef enum {
 
 typedef struct {
 	uint8_t i2c_tx_buffer[SH1106_I2C_BUFFER_SIZE_BYTES];
-	uint8_t i2c_rx_buffer[SH1106_I2C_BUFFER_SIZE_BYTES];
-	uint8_t ram_data[SH1106_SCREEN_WIDTH_PIXELS];
+	// Page transfers are chained on the I2C bus while the next one is built.
+	uint8_t page_tx_buffer[SH1106_PAGE_BUFFER_NUMBER][SH1106_PAGE_BUFFER_SIZE_BYTES];
+	uint8_t page_tx_buffer_idx;
+	// Local copy of the screen.
+	uint8_t frame_buffer[SH1106_SCREEN_HEIGHT_LINE][SH1106_SCREEN_WIDTH_PIXELS];
+	// Columns range to send on each page (nothing to send if start is greater or equal to end).
+	uint8_t dirty_column_start[SH1106_SCREEN_HEIGHT_LINE];
+	uint8_t dirty_column_end[SH1106_SCREEN_HEIGHT_LINE];
+	uint8_t display_on;
 } SH1106_context_t;
 
 /*** SH1106 local global variables ***/
@@ -113,17 +124,15 @@ errors:
 	return status;
 }
 
-/* SET SH1106 DISPLAY ADDRESS.
+/* BUILD SH1106 PAGE TRANSFER HEADER (ADDRESS COMMANDS FOLLOWED BY RAM CONTROL BYTE).
+ * @param buffer:	Buffer where to write the header.
  * @param page:		Page address.
  * @param column:	Column address.
- * @param line:		Line address.
  * @return status:	Function execution status.
  */
-SH1106_status_t _SH1106_set_address(uint8_t page, uint8_t column, uint8_t line) {
+static SH1106_status_t _SH1106_build_page_header(uint8_t* buffer, uint8_t page, uint8_t column) {
 	// Local variables.
 	SH1106_status_t status = SH1106_SUCCESS;
-	const uint8_t command_list_size = 4;
-	uint8_t command_list[command_list_size];
 	// Check parameters.
 	if (page > SH1106_SCREEN_HEIGHT_LINE) {
 		status = SH1106_ERROR_PAGE_ADDRESS;
@@ -133,17 +142,78 @@ SH1106_status_t _SH1106_set_address(uint8_t page, uint8_t column, uint8_t line)
 		status = SH1106_ERROR_COLUMN_ADDRESS;
 		goto errors;
 	}
-	if (line > SH1106_SCREEN_HEIGHT_PIXELS) {
-		status = SH1106_ERROR_LINE_ADDRESS;
-		goto errors;
+	// Build commands (each one preceded by a control byte with Co='1' and D/C='0').
+	buffer[0] = 0x80;
+	buffer[1] = 0xB0 | (page & 0x0F);
+	buffer[2] = 0x80;
+	buffer[3] = 0x00 | (((column + SH1106_OFFSET_WIDTH_PIXELS) >> 0) & 0x0F);
+	buffer[4] = 0x80;
+	buffer[5] = 0x10 | (((column + SH1106_OFFSET_WIDTH_PIXELS) >> 4) & 0x0F);
+	buffer[6] = 0x80;
+	buffer[7] = 0x40 | (SH1106_OFFSET_HEIGHT_PIXELS & 0x3F);
+	// Last control byte with Co='0' and D/C='1': all following bytes are RAM data.
+	buffer[8] = 0x40;
+errors:
+	return status;
+}
+
+/* WRITE ONE BYTE OF THE FRAME BUFFER.
+ * @param page:		Page address.
+ * @param column:	Column address.
+ * @param data:		Byte to write.
+ * @return:			None.
+ */
+static void _SH1106_write_frame_buffer(uint8_t page, uint8_t column, uint8_t data) {
+	// Check if the byte changes.
+	if (sh1106_ctx.frame_buffer[page][column] == data) return;
+	sh1106_ctx.frame_buffer[page][column] = data;
+	// Extend dirty range of the page.
+	if (column < sh1106_ctx.dirty_column_start[page]) {
+		sh1106_ctx.dirty_column_start[page] = column;
 	}
-	// Build commands.
-	command_list[0] = 0xB0 | (page & 0x0F);
-	command_list[1] = 0x00 | (((column + SH1106_OFFSET_WIDTH_PIXELS) >> 0) & 0x0F);
-	command_list[2] = 0x10 | (((column + SH1106_OFFSET_WIDTH_PIXELS) >> 4) & 0x0F);
-	command_list[3] = 0x40 | ((line + SH1106_OFFSET_HEIGHT_PIXELS) & 0x3F);
-	status = _SH1106_write(SH1106_DATA_TYPE_COMMAND, command_list, command_list_size);
-	if (status != SH1106_SUCCESS) goto errors;
+	if (column >= sh1106_ctx.dirty_column_end[page]) {
+		sh1106_ctx.dirty_column_end[page] = (column + 1);
+	}
+}
+
+/* SEND ALL DIRTY RANGES OF THE FRAME BUFFER TO SH1106 DISPLAY RAM.
+ * @param:			None.
+ * @return status:	Function execution status.
+ */
+static SH1106_status_t _SH1106_flush_frame_buffer(void) {
+	// Local variables.
+	SH1106_status_t status = SH1106_SUCCESS;
+	I2C_status_t i2c1_status = I2C_SUCCESS;
+	uint8_t* page_tx_buffer = NULL;
+	uint8_t page = 0;
+	uint8_t column = 0;
+	uint8_t idx = 0;
+	// Page loop.
+	for (page=0 ; page<SH1106_SCREEN_HEIGHT_LINE ; page++) {
+		// Skip clean pages.
+		if (sh1106_ctx.dirty_column_start[page] >= sh1106_ctx.dirty_column_end[page]) continue;
+		// Wait for the previous transfer of the selected buffer to complete.
+		i2c1_status = I2C1_wait(SH1106_PAGE_BUFFER_NUMBER - 1);
+		I2C1_status_check(SH1106_ERROR_BASE_I2C);
+		page_tx_buffer = sh1106_ctx.page_tx_buffer[sh1106_ctx.page_tx_buffer_idx];
+		// Build header and copy dirty range only.
+		status = _SH1106_build_page_header(page_tx_buffer, page, sh1106_ctx.dirty_column_start[page]);
+		if (status != SH1106_SUCCESS) goto errors;
+		idx = SH1106_PAGE_HEADER_SIZE_BYTES;
+		for (column=sh1106_ctx.dirty_column_start[page] ; column<sh1106_ctx.dirty_column_end[page] ; column++) {
+			page_tx_buffer[idx++] = sh1106_ctx.frame_buffer[page][column];
+		}
+		// Queue transfer.
+		i2c1_status = I2C1_write_async(SH1106_I2C_ADDRESS, page_tx_buffer, idx, 1, NULL);
+		I2C1_status_check(SH1106_ERROR_BASE_I2C);
+		sh1106_ctx.page_tx_buffer_idx = (sh1106_ctx.page_tx_buffer_idx + 1) % SH1106_PAGE_BUFFER_NUMBER;
+		// Page is now clean.
+		sh1106_ctx.dirty_column_start[page] = SH1106_SCREEN_WIDTH_PIXELS;
+		sh1106_ctx.dirty_column_end[page] = 0;
+	}
+	// Wait for all transfers to complete.
+	i2c1_status = I2C1_wait(0);
+	I2C1_status_check(SH1106_ERROR_BASE_I2C);
 errors:
 	return status;
 }
@@ -155,17 +225,18 @@ errors:
 SH1106_status_t _SH1106_clear_ram(void) {
 	// Local variables.
 	SH1106_status_t status = SH1106_SUCCESS;
-	uint8_t idx = 0;
-	// Reset data.
-	for (idx=0 ; idx<SH1106_RAM_WIDTH_PIXELS ; idx++) sh1106_ctx.ram_data[idx] = 0x00;
+	uint8_t page = 0;
+	uint8_t column = 0;
 	// Page loop.
-	for (idx=0 ; idx<SH1106_SCREEN_HEIGHT_LINE ; idx++) {
-		// Clear RAM page.
-		status = _SH1106_set_address(idx, 0, 0);
-		if (status != SH1106_SUCCESS) goto errors;
-		status = _SH1106_write(SH1106_DATA_TYPE_RAM, sh1106_ctx.ram_data, SH1106_RAM_WIDTH_PIXELS);
-		if (status != SH1106_SUCCESS) goto errors;
+	for (page=0 ; page<SH1106_SCREEN_HEIGHT_LINE ; page++) {
+		// Reset frame buffer.
+		for (column=0 ; column<SH1106_SCREEN_WIDTH_PIXELS ; column++) sh1106_ctx.frame_buffer[page][column] = 0x00;
+		// Display RAM content is unknown: force full page update.
+		sh1106_ctx.dirty_column_start[page] = 0;
+		sh1106_ctx.dirty_column_end[page] = SH1106_SCREEN_WIDTH_PIXELS;
 	}
+	status = _SH1106_flush_frame_buffer();
+	if (status != SH1106_SUCCESS) goto errors;
 errors:
 	return status;
 }
@@ -183,6 +254,8 @@ SH1106_status_t _SH1106_on_off(uint8_t on_off_flag) {
 	// Send command.
 	status = _SH1106_write(SH1106_DATA_TYPE_COMMAND, &command, 1);
 	if (status != SH1106_SUCCESS) goto errors;
+	// Update context.
+	sh1106_ctx.display_on = (on_off_flag & 0x01);
 errors:
 	return status;
 }
@@ -196,6 +269,9 @@ errors:
 SH1106_status_t SH1106_init(void) {
 	// Local variables.
 	SH1106_status_t status = SH1106_SUCCESS;
+	// Init context.
+	sh1106_ctx.display_on = 0;
+	sh1106_ctx.page_tx_buffer_idx = 0;
 	// Screen configuration.
 	status = _SH1106_setup();
 	if (status != SH1106_SUCCESS) goto errors;
@@ -213,17 +289,39 @@ errors:
 SH1106_status_t SH1106_clear(void) {
 	// Local variables.
 	SH1106_status_t status = SH1106_SUCCESS;
+	uint8_t page = 0;
+	uint8_t column = 0;
 	// Turn display off.
 	status = _SH1106_on_off(0);
 	if (status != SH1106_SUCCESS) goto errors;
-	// Clear RAM.
-	status = _SH1106_clear_ram();
+	// Clear frame buffer (display RAM will be updated on next flush).
+	for (page=0 ; page<SH1106_SCREEN_HEIGHT_LINE ; page++) {
+		for (column=0 ; column<SH1106_SCREEN_WIDTH_PIXELS ; column++) _SH1106_write_frame_buffer(page, column, 0x00);
+	}
+errors:
+	return status;
+}
+
+/* SEND ALL PENDING DRAWINGS TO THE SCREEN AND TURN IT ON.
+ * @param:			None.
+ * @return status:	Function execution status.
+ */
+SH1106_status_t SH1106_flush(void) {
+	// Local variables.
+	SH1106_status_t status = SH1106_SUCCESS;
+	// Update display RAM.
+	status = _SH1106_flush_frame_buffer();
 	if (status != SH1106_SUCCESS) goto errors;
+	// Turn display on.
+	if (sh1106_ctx.display_on == 0) {
+		status = _SH1106_on_off(1);
+		if (status != SH1106_SUCCESS) goto errors;
+	}
 errors:
 	return status;
 }
 
-/* PRINT TEXT ON OLED SCREEN.
+/* PRINT TEXT IN FRAME BUFFER.
  * @param text:		Text structure to print.
  * @return status:	Function execution status.
  */
@@ -231,14 +329,16 @@ SH1106_status_t SH1106_print_text(SH1106_text_t* text) {
 	// Local variables.
 	SH1106_status_t status = SH1106_SUCCESS;
 	STRING_status_t string_status = STRING_SUCCESS;
-	uint8_t ram_idx = 0;
 	uint8_t text_size = 0;
 	uint8_t text_width_pixels = 0;
 	uint8_t text_column = 0;
 	uint8_t flush_column = 0;
-	uint8_t text_idx = 0;
+	uint8_t first_column = 0;
+	uint8_t last_column = 0;
+	uint8_t column = 0;
 	uint8_t line_idx = 0;
 	uint8_t ascii_code = 0;
+	uint8_t data = 0;
 	// Check parameter.
 	if (text == NULL) {
 		status = SH1106_ERROR_NULL_PARAMETER;
@@ -248,6 +348,10 @@ SH1106_status_t SH1106_print_text(SH1106_text_t* text) {
 		status = SH1106_ERROR_NULL_PARAMETER;
 		goto errors;
 	}
+	if ((text -> page) >= SH1106_SCREEN_HEIGHT_LINE) {
+		status = SH1106_ERROR_PAGE_ADDRESS;
+		goto errors;
+	}
 	if ((text -> contrast) >= SH1106_TEXT_CONTRAST_LAST) {
 		status = SH1106_ERROR_CONTRAST;
 		goto errors;
@@ -287,63 +391,43 @@ SH1106_status_t SH1106_print_text(SH1106_text_t* text) {
 		status = (HMI_ERROR_BASE_STRING + STRING_ERROR_TEXT_JUSTIFICATION);
 		goto errors;
 	}
-	// Reset RAM data.
-	for (ram_idx=0 ; ram_idx<SH1106_RAM_WIDTH_PIXELS ; ram_idx++) sh1106_ctx.ram_data[ram_idx] = 0x00;
-	// Build RAM data.
-	ram_idx = text_column;
-	text_idx = 0;
-	while ((text -> str)[text_idx] != STRING_CHAR_NULL) {
-		// Get ASCII code.
-		ascii_code = (uint8_t) (text -> str)[text_idx];
-		// Line loop.
-		for (line_idx=0 ; line_idx<FONT_CHAR_WIDTH_PIXELS ; line_idx++) {
-			// Check index.
-			if (ram_idx >= SH1106_SCREEN_WIDTH_PIXELS) {
-				status = SH1106_ERROR_TEXT_WIDTH_OVERFLOW;
-				goto errors;
-			}
-			// Fill RAM.
-			sh1106_ctx.ram_data[ram_idx] = (ascii_code < FONT_ASCII_TABLE_OFFSET) ? FONT[0][line_idx] : FONT[ascii_code - FONT_ASCII_TABLE_OFFSET][line_idx];
+	// Compute columns range to update.
+	first_column = ((text -> flush_width_pixels) == 0) ? text_column : flush_column;
+	last_column = ((text -> flush_width_pixels) == 0) ? (text_column + text_width_pixels) : (flush_column + (text -> flush_width_pixels));
+	// Columns loop.
+	for (column=first_column ; column<last_column ; column++) {
+		// Get font data (blank outside text).
+		data = 0x00;
+		if ((column >= text_column) && (column < (text_column + text_width_pixels))) {
+			ascii_code = (uint8_t) (text -> str)[(column - text_column) / FONT_CHAR_WIDTH_PIXELS];
+			line_idx = ((column - text_column) % FONT_CHAR_WIDTH_PIXELS);
+			data = (ascii_code < FONT_ASCII_TABLE_OFFSET) ? FONT[0][line_idx] : FONT[ascii_code - FONT_ASCII_TABLE_OFFSET][line_idx];
 			if ((text -> vertical_position) == SH1106_TEXT_VERTICAL_POSITION_BOTTOM) {
-				sh1106_ctx.ram_data[ram_idx] <<= 1;
+				data <<= 1;
 			}
-			ram_idx++;
 		}
-		text_idx++;
-	}
-	// Manage contrast.
-	if ((text -> contrast) == SH1106_TEXT_CONTRAST_INVERTED) {
-		for (ram_idx=0 ; ram_idx<SH1106_SCREEN_WIDTH_PIXELS ; ram_idx++) sh1106_ctx.ram_data[ram_idx] ^= 0xFF;
-	}
-	// Check flush width.
-	if ((text -> flush_width_pixels) == 0) {
-		// Set address.
-		status = _SH1106_set_address((text -> page), text_column, 0);
-		if (status != SH1106_SUCCESS) goto errors;
-		// Write line.
-		status = _SH1106_write(SH1106_DATA_TYPE_RAM, &(sh1106_ctx.ram_data[text_column]), text_width_pixels);
-		if (status != SH1106_SUCCESS) goto errors;
-	}
-	else {
-		// Set address.
-		status = _SH1106_set_address((text -> page), flush_column, 0);
-		if (status != SH1106_SUCCESS) goto errors;
-		// Write line.
-		status = _SH1106_write(SH1106_DATA_TYPE_RAM, &(sh1106_ctx.ram_data[flush_column]), (text -> flush_width_pixels));
-		if (status != SH1106_SUCCESS) goto errors;
+		// Manage contrast.
+		if ((text -> contrast) == SH1106_TEXT_CONTRAST_INVERTED) {
+			data ^= 0xFF;
+		}
+		_SH1106_write_frame_buffer((text -> page), column, data);
 	}
-	// Turn display on.
-	status = _SH1106_on_off(1);
-	if (status != SH1106_SUCCESS) goto errors;
 errors:
 	return status;
 }
 
+/* PRINT HORIZONTAL LINE IN FRAME BUFFER.
+ * @param horizontal_line:	Line structure to print.
+ * @return status:			Function execution status.
+ */
 SH1106_status_t SH1106_print_horizontal_line(SH1106_horizontal_line_t* horizontal_line) {
 	// Local variables.
 	SH1106_status_t status = SH1106_SUCCESS;
 	uint8_t line_column = 0;
-	uint8_t ram_idx = 0;
+	uint8_t first_column = 0;
+	uint8_t last_column = 0;
+	uint8_t column = 0;
+	uint8_t data = 0;
 	// Check parameters.
 	if (horizontal_line == NULL) {
 		status = SH1106_ERROR_NULL_PARAMETER;
@@ -372,54 +456,40 @@ SH1106_status_t SH1106_print_horizontal_line(SH1106_horizontal_line_t* horizonta
 		status = (HMI_ERROR_BASE_STRING + STRING_ERROR_TEXT_JUSTIFICATION);
 		goto errors;
 	}
-	// Build RAM data.
-	for (ram_idx=0 ; ram_idx<SH1106_RAM_WIDTH_PIXELS ; ram_idx++) {
-		sh1106_ctx.ram_data[ram_idx] = ((ram_idx >= line_column) && (ram_idx < (line_column + (horizontal_line -> width_pixels)))) ? (0b1 << ((horizontal_line -> line_pixels) % 8)) : 0x00;
-	}
-	// Manage contrast.
-	if ((horizontal_line -> contrast) == SH1106_TEXT_CONTRAST_INVERTED) {
-		for (ram_idx=0 ; ram_idx<SH1106_SCREEN_WIDTH_PIXELS ; ram_idx++) sh1106_ctx.ram_data[ram_idx] ^= 0xFF;
-	}
-	// Check line erase flag.
-	if ((horizontal_line -> flush_flag) != 0) {
-		// Set address.
-		status = _SH1106_set_address(((horizontal_line -> line_pixels) / 8), 0, 0);
-		if (status != SH1106_SUCCESS) goto errors;
-		// Write line.
-		status = _SH1106_write(SH1106_DATA_TYPE_RAM, sh1106_ctx.ram_data, SH1106_SCREEN_WIDTH_PIXELS);
-		if (status != SH1106_SUCCESS) goto errors;
-	}
-	else {
-		// Set address.
-		status = _SH1106_set_address(((horizontal_line -> line_pixels) / 8), line_column, 0);
-		if (status != SH1106_SUCCESS) goto errors;
-		// Write line.
-		status = _SH1106_write(SH1106_DATA_TYPE_RAM, &(sh1106_ctx.ram_data[line_column]), (horizontal_line -> width_pixels));
-		if (status != SH1106_SUCCESS) goto errors;
+	// Compute columns range to update.
+	first_column = ((horizontal_line -> flush_flag) != 0) ? 0 : line_column;
+	last_column = ((horizontal_line -> flush_flag) != 0) ? SH1106_SCREEN_WIDTH_PIXELS : (line_column + (horizontal_line -> width_pixels));
+	// Columns loop.
+	for (column=first_column ; column<last_column ; column++) {
+		data = ((column >= line_column) && (column < (line_column + (horizontal_line -> width_pixels)))) ? (0b1 << ((horizontal_line -> line_pixels) % 8)) : 0x00;
+		// Manage contrast.
+		if ((horizontal_line -> contrast) == SH1106_TEXT_CONTRAST_INVERTED) {
+			data ^= 0xFF;
+		}
+		_SH1106_write_frame_buffer(((horizontal_line -> line_pixels) / 8), column, data);
 	}
 errors:
 	return status;
 }
 
-/* INIT SH1106 DRIVER.
- * @param:			None.
+/* PRINT IMAGE IN FRAME BUFFER.
+ * @param image:	Full screen image to print.
  * @return status:	Function execution status.
  */
 SH1106_status_t SH1106_print_image(const uint8_t image[SH1106_SCREEN_HEIGHT_LINE][SH1106_SCREEN_WIDTH_PIXELS]) {
 	// Local variables.
 	SH1106_status_t status = SH1106_SUCCESS;
 	uint8_t page = 0;
+	uint8_t column = 0;
+	// Check parameter.
+	if (image == NULL) {
+		status = SH1106_ERROR_NULL_PARAMETER;
+		goto errors;
+	}
 	// Page loop.
 	for (page=0 ; page<SH1106_SCREEN_HEIGHT_LINE ; page++) {
-		// Display line.
-		status = _SH1106_set_address(page, 0, 0);
-		if (status != SH1106_SUCCESS) goto errors;
-		status = _SH1106_write(SH1106_DATA_TYPE_RAM, (uint8_t*) image[page], SH1106_SCREEN_WIDTH_PIXELS);
-		if (status != SH1106_SUCCESS) goto errors;
+		for (column=0 ; column<SH1106_SCREEN_WIDTH_PIXELS ; column++) _SH1106_write_frame_buffer(page, column, image[page][column]);
 	}
-	// Turn display on.
-	status = _SH1106_on_off(1);
-	if (status != SH1106_SUCCESS) goto errors;
 errors:
 	return status;
 }
@@ -22,6 +22,8 @@
 #include "rcc.h"
 #include "rtc.h"
 // Utils.
+#include "event.h"
+#include "scheduler.h"
 #include "types.h"
 // Components.
 #include "led.h"
@@ -49,24 +51,22 @@ typedef union {
 } DIM_status_t;
 
 typedef enum {
-	DMM_STATE_INIT,
-	DMM_STATE_MEASURE,
-	DMM_STATE_HMI,
-	DMM_STATE_NODE_TASK,
-	DMM_STATE_OFF,
-	DMM_STATE_SLEEP,
-	DMM_STATE_LAST,
-} DMM_state_t;
+	DMM_TASK_HMI = 0,
+	DMM_TASK_NODE,
+	DMM_TASK_MEASURE,
+	DMM_TASK_LAST
+} DMM_task_t;
 
 typedef struct {
 	// Global.
-	DMM_state_t state;
 	DIM_status_t status;
 	// Clocks.
 	uint32_t lsi_frequency_hz;
 	uint8_t lse_running;
 	// Internal measurements.
 	uint32_t measurements_next_time_seconds;
+	// Events.
+	uint32_t event_overflow_count;
 } DMM_context_t;
 
 /*** MAIN local global variables ***/
@@ -81,13 +81,84 @@ static DMM_context_t dmm_ctx;
  */
 void _DMM_init_context(void) {
 	// Init context.
-	dmm_ctx.state = DMM_STATE_INIT;
 	dmm_ctx.lsi_frequency_hz = 0;
 	dmm_ctx.lse_running = 0;
 	dmm_ctx.status.all = 0;
 	dmm_ctx.measurements_next_time_seconds = 0;
+	dmm_ctx.event_overflow_count = 0;
 }
 
+/* HMI TASK READY CALLBACK.
+ * @param:	None.
+ * @return:	1 if the encoder switch has been pressed, 0 otherwise.
+ */
+static uint8_t _DMM_hmi_task_ready(void) {
+	return HMI_get_activation_flag();
+}
+
+/* HMI TASK.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _DMM_hmi_task(void) {
+	// Local variables.
+	HMI_status_t hmi_status = HMI_SUCCESS;
+	// Process HMI.
+	hmi_status = HMI_task();
+	HMI_error_check();
+	// Enable HMI activation interrupt.
+	NVIC_enable_interrupt(NVIC_INTERRUPT_EXTI_0_1);
+}
+
+/* NODE TASK READY CALLBACK.
+ * @param:	None.
+ * @return:	1 if the node layer has something to do, 0 otherwise.
+ */
+static uint8_t _DMM_node_task_ready(void) {
+	return ((RTC_get_time_seconds() >= NODE_get_next_time_seconds()) ? 1 : 0);
+}
+
+/* NODE TASK.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _DMM_node_task(void) {
+	// Local variables.
+	NODE_status_t node_status = NODE_SUCCESS;
+	// Process nodes task (returns early when the HMI has to be started).
+	node_status = NODE_task();
+	NODE_error_check();
+}
+
+/* MEASURE TASK READY CALLBACK.
+ * @param:	None.
+ * @return:	1 if the measurements period is reached, 0 otherwise.
+ */
+static uint8_t _DMM_measure_task_ready(void) {
+	return ((RTC_get_time_seconds() >= dmm_ctx.measurements_next_time_seconds) ? 1 : 0);
+}
+
+/* MEASURE TASK.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _DMM_measure_task(void) {
+	// Local variables.
+	ADC_status_t adc1_status = ADC_SUCCESS;
+	// Update period.
+	dmm_ctx.measurements_next_time_seconds = RTC_get_time_seconds() + DMM_MEASUREMENTS_PERIOD_SECONDS;
+	// Perform analog measurements.
+	adc1_status = ADC1_perform_measurements();
+	ADC1_error_check();
+}
+
+// Note: table is indexed with DMM_task_t (sorted by decreasing priority).
+static const SCHEDULER_task_t DMM_TASKS[DMM_TASK_LAST] = {
+	{&_DMM_hmi_task_ready, &_DMM_hmi_task},
+	{&_DMM_node_task_ready, &_DMM_node_task},
+	{&_DMM_measure_task_ready, &_DMM_measure_task}
+};
+
 /* COMMON INIT FUNCTION FOR PERIPHERALS AND COMPONENTS.
  * @param:	None.
  * @return:	None.
@@ -97,6 +168,7 @@ void _DMM_init_hw(void) {
 	RCC_status_t rcc_status = RCC_SUCCESS;
 	RTC_status_t rtc_status = RTC_SUCCESS;
 	ADC_status_t adc1_status = ADC_SUCCESS;
+	SCHEDULER_status_t scheduler_status = SCHEDULER_SUCCESS;
 #ifndef DEBUG
 	IWDG_status_t iwdg_status = IWDG_SUCCESS;
 #endif
@@ -105,6 +177,10 @@ void _DMM_init_hw(void) {
 	// Init memory.
 	NVIC_init();
 	NVM_init();
+	// Init events dispatcher (before any interrupt source) and tasks scheduler.
+	EVENT_init();
+	scheduler_status = SCHEDULER_init(DMM_TASKS, DMM_TASK_LAST);
+	SCHEDULER_error_check();
 	// Init GPIOs.
 	GPIO_init();
 	EXTI_init();
@@ -170,78 +246,26 @@ int main(void) {
 	_DMM_init_context();
 	_DMM_init_hw();
 	// Local variables.
-	ADC_status_t adc1_status = ADC_SUCCESS;
 	LPUART_status_t lpuart1_status = LPUART_SUCCESS;
 	NODE_status_t node_status = NODE_SUCCESS;
-	HMI_status_t hmi_status = HMI_SUCCESS;
+	// Turn bus interface on.
+	lpuart1_status = LPUART1_power_on();
+	LPUART1_error_check();
+	// Restore known nodes (remaining addresses are scanned in background by node task).
+	node_status = NODE_warm_scan();
+	NODE_error_check();
+	// Turn bus interface off.
+	LPUART1_power_off();
+	// Enable HMI activation interrupt.
+	NVIC_enable_interrupt(NVIC_INTERRUPT_EXTI_0_1);
 	// Main loop.
 	while (1) {
-		// Perform state machine.
-		switch (dmm_ctx.state) {
-		case DMM_STATE_INIT:
-			// Turn bus interface on.
-			lpuart1_status = LPUART1_power_on();
-			LPUART1_error_check();
-			// Perform first nodes scan.
-			node_status = NODE_scan();
-			NODE_error_check();
-			// Turn bus interface off.
-			LPUART1_power_off();
-			// Compute next state.
-			dmm_ctx.state = DMM_STATE_MEASURE;
-			break;
-		case DMM_STATE_HMI:
-			// Process HMI.
-			hmi_status = HMI_task();
-			HMI_error_check();
-			// Compute next state.
-			dmm_ctx.state = DMM_STATE_OFF;
-			break;
-		case DMM_STATE_NODE_TASK:
-			// Process nodes_task.
-			node_status = NODE_task();
-			NODE_error_check();
-			// Compute next state.
-			dmm_ctx.state = DMM_STATE_MEASURE;
-			break;
-		case DMM_STATE_MEASURE:
-			// Check period.
-			if (RTC_get_time_seconds() >= dmm_ctx.measurements_next_time_seconds) {
-				// Update period.
-				dmm_ctx.measurements_next_time_seconds = RTC_get_time_seconds() + DMM_MEASUREMENTS_PERIOD_SECONDS;
-				// Perform analog measurements.
-				adc1_status = ADC1_perform_measurements();
-				ADC1_error_check();
-			}
-			// Compute next state.
-			dmm_ctx.state = DMM_STATE_OFF;
-			break;
-		case DMM_STATE_OFF:
-			// Enable HMI activation interrupt.
-			NVIC_enable_interrupt(NVIC_INTERRUPT_EXTI_0_1);
-			// Compute next state.
-			dmm_ctx.state = DMM_STATE_SLEEP;
-			break;
-		case DMM_STATE_SLEEP:
-			// Enter sleep mode.
-			PWR_enter_stop_mode();
-			// Wake-up
-			IWDG_reload();
-			// Check HMI activation flag.
-			if (EXTI_get_encoder_switch_flag() != 0) {
-				// Clear flag.
-				EXTI_clear_encoder_switch_flag();
-				// Start HMI.
-				dmm_ctx.state = DMM_STATE_HMI;
-			}
-			else {
-				// Perform node task.
-				dmm_ctx.state = DMM_STATE_NODE_TASK;
-			}
-			break;
-		default:
-			dmm_ctx.state = DMM_STATE_SLEEP;
-			break;
+		// Run the highest priority ready task or enter stop mode.
+		SCHEDULER_run();
+		// Report lost interrupt events.
+		if (EVENT_get_overflow_count() != dmm_ctx.event_overflow_count) {
+			dmm_ctx.event_overflow_count = EVENT_get_overflow_count();
+			ERROR_stack_add(ERROR_EVENT_OVERFLOW);
 		}
 		IWDG_reload();
 	}
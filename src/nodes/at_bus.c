@@ -8,6 +8,7 @@
 #include "at_bus.h"
 
 #include "dinfox.h"
+#include "event.h"
 #include "gpio.h"
 #include "iwdg.h"
 #include "lbus.h"
@@ -16,6 +17,7 @@
 #include "mapping.h"
 #include "parser.h"
 #include "node.h"
+#include "scheduler.h"
 #include "string.h"
 
 /*** AT local macros ***/
@@ -25,23 +27,33 @@
 #define AT_BUS_BUFFER_SIZE_BYTES		64
 #define AT_BUS_REPLY_BUFFER_DEPTH		16
 
-#define AT_BUS_REPLY_PARSING_DELAY_MS	50
+#define AT_BUS_REPLY_DEADLINE_MS_MAX	5000
 #define AT_BUS_SEQUENCE_TIMEOUT_MS		120000
 
-#define AT_BUS_COMMAND_PING				"AT"
 #define AT_BUS_COMMAND_WRITE_REGISTER	"AT$W="
 #define AT_BUS_COMMAND_READ_REGISTER	"AT$R="
 #define AT_BUS_COMMAND_SEPARATOR		","
+#define AT_BUS_CHAR_SEPARATOR			','
+
+// Widest register value is a signed 32-bits decimal ("-2147483648"), each value but the last is followed by a separator and the reply is null terminated.
+#define AT_BUS_REGISTER_VALUE_SIZE_MAX	11
+#define AT_BUS_BURST_READ_REGISTERS_MAX	(AT_BUS_BUFFER_SIZE_BYTES / (AT_BUS_REGISTER_VALUE_SIZE_MAX + 1))
 
 #define AT_BUS_REPLY_OK					"OK"
 #define AT_BUS_REPLY_ERROR				"ERROR"
 
 /*** AT local structures ***/
 
+typedef struct {
+	NODE_address_t start;
+	uint8_t range;
+} AT_BUS_address_range_t;
+
 typedef struct {
 	volatile char_t buffer[AT_BUS_BUFFER_SIZE_BYTES];
 	volatile uint8_t size;
-	volatile uint8_t line_end_flag;
+	volatile uint8_t overflow_flag; // Set by the interrupt when the line does not fit in the buffer.
+	volatile uint8_t line_end_flag; // Set by the interrupt when the line is complete.
 	PARSER_context_t parser;
 } AT_BUS_reply_buffer_t;
 
@@ -53,10 +65,24 @@ typedef struct {
 	AT_BUS_reply_buffer_t reply[AT_BUS_REPLY_BUFFER_DEPTH];
 	volatile uint8_t reply_write_idx;
 	uint8_t reply_read_idx;
+	// Nodes which answered a burst read with an invalid reply (bit index is the node address).
+	uint8_t burst_unsupported[(DINFOX_NODE_ADDRESS_LBUS_LAST / 8) + 1];
 } AT_BUS_context_t;
 
 /*** AT local global variables ***/
 
+static const AT_BUS_address_range_t AT_BUS_SCAN_RANGES[] = {
+	{DINFOX_NODE_ADDRESS_DIM, 1},
+	{DINFOX_NODE_ADDRESS_BPSM_START, DINFOX_NODE_ADDRESS_RANGE_BPSM},
+	{DINFOX_NODE_ADDRESS_UHFM_START, DINFOX_NODE_ADDRESS_RANGE_UHFM},
+	{DINFOX_NODE_ADDRESS_GPSM_START, DINFOX_NODE_ADDRESS_RANGE_GPSM},
+	{DINFOX_NODE_ADDRESS_SM_START, DINFOX_NODE_ADDRESS_RANGE_SM},
+	{DINFOX_NODE_ADDRESS_RRM_START, DINFOX_NODE_ADDRESS_RANGE_RRM},
+	{DINFOX_NODE_ADDRESS_MPMCM_START, DINFOX_NODE_ADDRESS_RANGE_MPMCM},
+	{DINFOX_NODE_ADDRESS_LVRM_START, DINFOX_NODE_ADDRESS_RANGE_LVRM},
+	{DINFOX_NODE_ADDRESS_DDRM_START, DINFOX_NODE_ADDRESS_RANGE_DDRM},
+};
+
 static AT_BUS_context_t at_bus_ctx;
 
 /*** AT local functions ***/
@@ -80,7 +106,8 @@ static void _AT_BUS_flush_command(void) {
 static void _AT_BUS_flush_reply(uint8_t reply_index) {
 	// Flush buffer.
 	at_bus_ctx.reply[reply_index].size = 0;
-	// Reset flag.
+	// Reset flags.
+	at_bus_ctx.reply[reply_index].overflow_flag = 0;
 	at_bus_ctx.reply[reply_index].line_end_flag = 0;
 	// Reset parser.
 	at_bus_ctx.reply[reply_index].parser.buffer = (char_t*) at_bus_ctx.reply[reply_index].buffer;
@@ -96,6 +123,8 @@ static void _AT_BUS_flush_reply(uint8_t reply_index) {
 static void _AT_BUS_flush_replies(void) {
 	// Local variabless.
 	uint8_t rep_idx = 0;
+	// Drain pending line end notifications of the previous command.
+	EVENT_dispatch();
 	// Reset replys buffers.
 	for (rep_idx=0 ; rep_idx<AT_BUS_REPLY_BUFFER_DEPTH ; rep_idx++) {
 		_AT_BUS_flush_reply(rep_idx);
@@ -105,6 +134,31 @@ static void _AT_BUS_flush_replies(void) {
 	at_bus_ctx.reply_read_idx = 0;
 }
 
+/* WAIT FOR A LINE END OR A DEADLINE.
+ * @param deadline_ms:	Maximum waiting time in ms.
+ * @param elapsed_ms:	Pointer to the effective waiting time in ms.
+ * @return status:		Function execution status.
+ */
+static NODE_status_t _AT_BUS_wait_line_end(uint32_t deadline_ms, uint32_t* elapsed_ms) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	LPTIM_status_t lptim1_status = LPTIM_SUCCESS;
+	// Start deadline timer.
+	lptim1_status = LPTIM1_start(deadline_ms);
+	LPTIM1_status_check(NODE_ERROR_BASE_LPTIM);
+	// Enter stop mode until a line end is received (LPUART interrupt) or the deadline is reached (LPTIM interrupt).
+	EVENT_dispatch();
+	while ((at_bus_ctx.reply[at_bus_ctx.reply_read_idx].line_end_flag == 0) && (LPTIM1_get_wake_up_flag() == 0)) {
+		SCHEDULER_yield();
+	}
+	// Compute effective waiting time.
+	(*elapsed_ms) = (LPTIM1_get_wake_up_flag() != 0) ? deadline_ms : LPTIM1_get_elapsed_milliseconds();
+errors:
+	LPTIM1_stop();
+	IWDG_reload();
+	return status;
+}
+
 /* WAIT FOR RECEIVING A VALUE.
  * @param reply_params:	Pointer to the reply parameters.
  * @param read_data:	Pointer to the reply data.
@@ -115,9 +169,10 @@ NODE_status_t _AT_BUS_wait_reply(NODE_reply_parameters_t* reply_params, NODE_rea
 	// Local variables.
 	NODE_status_t status = NODE_SUCCESS;
 	PARSER_status_t parser_status = PARSER_SUCCESS;
-	LPTIM_status_t lptim1_status = LPTIM_SUCCESS;
 	uint32_t reply_time_ms = 0;
 	uint32_t sequence_time_ms = 0;
+	uint32_t deadline_ms = 0;
+	uint32_t elapsed_ms = 0;
 	uint8_t reply_count = 0;
 	// Check parameters.
 	if ((reply_params == NULL) || (read_data == NULL) || (reply_status == NULL)) {
@@ -140,65 +195,74 @@ NODE_status_t _AT_BUS_wait_reply(NODE_reply_parameters_t* reply_params, NODE_rea
 	if ((reply_params -> type) == NODE_REPLY_TYPE_NONE) goto errors;
 	// Main reception loop.
 	while (1) {
-		// Delay.
-		lptim1_status = LPTIM1_delay_milliseconds(AT_BUS_REPLY_PARSING_DELAY_MS, LPTIM_DELAY_MODE_STOP);
-		LPTIM1_status_check(NODE_ERROR_BASE_LPTIM);
-		reply_time_ms += AT_BUS_REPLY_PARSING_DELAY_MS;
-		sequence_time_ms += AT_BUS_REPLY_PARSING_DELAY_MS;
-		// Check write index.
-		if (at_bus_ctx.reply_write_idx != at_bus_ctx.reply_read_idx) {
-			// Check line end flag.
-			if (at_bus_ctx.reply[at_bus_ctx.reply_read_idx].line_end_flag != 0) {
-				// Increment parsing count.
-				reply_count++;
-				// Reset time and flag.
-				reply_time_ms = 0;
-				at_bus_ctx.reply[at_bus_ctx.reply_read_idx].line_end_flag = 0;
-				// Update buffer length.
-				at_bus_ctx.reply[at_bus_ctx.reply_read_idx].parser.buffer_size = at_bus_ctx.reply[at_bus_ctx.reply_read_idx].size;
-				// Parse reply.
-				switch (reply_params -> type) {
-				case NODE_REPLY_TYPE_RAW:
-					// Do not parse.
-					parser_status = PARSER_SUCCESS;
-					break;
-				case NODE_REPLY_TYPE_OK:
-					// Compare to reference string.
-					parser_status = PARSER_compare(&at_bus_ctx.reply[at_bus_ctx.reply_read_idx].parser, PARSER_MODE_COMMAND, AT_BUS_REPLY_OK);
-					break;
-				case NODE_REPLY_TYPE_VALUE:
-					// Parse value.
-					parser_status = PARSER_get_parameter(&at_bus_ctx.reply[at_bus_ctx.reply_read_idx].parser, (reply_params -> format), STRING_CHAR_NULL, &(read_data -> value));
-					break;
-				case NODE_REPLY_TYPE_BYTE_ARRAY:
-					// Parse byte array.
-					parser_status = PARSER_get_byte_array(&at_bus_ctx.reply[at_bus_ctx.reply_read_idx].parser, STRING_CHAR_NULL, (reply_params -> byte_array_size), (reply_params -> exact_length), (read_data -> byte_array), &(read_data -> extracted_length));
-					break;
-				default:
-					status = NODE_ERROR_READ_TYPE;
-					break;
-				}
-				// Check status.
-				if (parser_status == PARSER_SUCCESS) {
-					// Update raw pointer, status and exit..
-					(reply_status -> all) = 0;
-					(read_data -> raw) = (char_t*) (at_bus_ctx.reply[at_bus_ctx.reply_read_idx].buffer);
-					break;
-				}
-				// Check error.
-				parser_status = PARSER_compare(&at_bus_ctx.reply[at_bus_ctx.reply_read_idx].parser, PARSER_MODE_HEADER, AT_BUS_REPLY_ERROR);
-				if (parser_status == PARSER_SUCCESS) {
-					// Update output data.
-					(reply_status -> error_received) = 1;
-					break;
-				}
+		// Wait for next line only if none is pending.
+		if (at_bus_ctx.reply[at_bus_ctx.reply_read_idx].line_end_flag == 0) {
+			// Compute deadline.
+			deadline_ms = ((reply_params -> timeout_ms) > reply_time_ms) ? ((reply_params -> timeout_ms) - reply_time_ms) : 1;
+			if (deadline_ms > AT_BUS_REPLY_DEADLINE_MS_MAX) {
+				deadline_ms = AT_BUS_REPLY_DEADLINE_MS_MAX;
+			}
+			status = _AT_BUS_wait_line_end(deadline_ms, &elapsed_ms);
+			if (status != NODE_SUCCESS) goto errors;
+			reply_time_ms += elapsed_ms;
+			sequence_time_ms += elapsed_ms;
+		}
+		// Check line end flag.
+		if (at_bus_ctx.reply[at_bus_ctx.reply_read_idx].line_end_flag != 0) {
+			// Increment parsing count.
+			reply_count++;
+			// Reset time and flag.
+			reply_time_ms = 0;
+			at_bus_ctx.reply[at_bus_ctx.reply_read_idx].line_end_flag = 0;
+			// Truncated line can not be parsed.
+			if (at_bus_ctx.reply[at_bus_ctx.reply_read_idx].overflow_flag != 0) {
+				(reply_status -> parser_error) = 1;
+				break;
+			}
+			// Update buffer length.
+			at_bus_ctx.reply[at_bus_ctx.reply_read_idx].parser.buffer_size = at_bus_ctx.reply[at_bus_ctx.reply_read_idx].size;
+			// Parse reply.
+			switch (reply_params -> type) {
+			case NODE_REPLY_TYPE_RAW:
+				// Do not parse.
+				parser_status = PARSER_SUCCESS;
+				break;
+			case NODE_REPLY_TYPE_OK:
+				// Compare to reference string.
+				parser_status = PARSER_compare(&at_bus_ctx.reply[at_bus_ctx.reply_read_idx].parser, PARSER_MODE_COMMAND, AT_BUS_REPLY_OK);
+				break;
+			case NODE_REPLY_TYPE_VALUE:
+				// Parse value.
+				parser_status = PARSER_get_parameter(&at_bus_ctx.reply[at_bus_ctx.reply_read_idx].parser, (reply_params -> format), STRING_CHAR_NULL, &(read_data -> value));
+				break;
+			case NODE_REPLY_TYPE_BYTE_ARRAY:
+				// Parse byte array.
+				parser_status = PARSER_get_byte_array(&at_bus_ctx.reply[at_bus_ctx.reply_read_idx].parser, STRING_CHAR_NULL, (reply_params -> byte_array_size), (reply_params -> exact_length), (read_data -> byte_array), &(read_data -> extracted_length));
+				break;
+			default:
+				status = NODE_ERROR_READ_TYPE;
+				break;
+			}
+			// Check status.
+			if (parser_status == PARSER_SUCCESS) {
+				// Update raw pointer, status and exit..
+				(reply_status -> all) = 0;
+				(read_data -> raw) = (char_t*) (at_bus_ctx.reply[at_bus_ctx.reply_read_idx].buffer);
+				break;
+			}
+			// Check error.
+			parser_status = PARSER_compare(&at_bus_ctx.reply[at_bus_ctx.reply_read_idx].parser, PARSER_MODE_HEADER, AT_BUS_REPLY_ERROR);
+			if (parser_status == PARSER_SUCCESS) {
+				// Update output data.
+				(reply_status -> error_received) = 1;
+				break;
 			}
 			// Update read index.
 			_AT_BUS_flush_reply(at_bus_ctx.reply_read_idx);
 			at_bus_ctx.reply_read_idx = (at_bus_ctx.reply_read_idx + 1) % AT_BUS_REPLY_BUFFER_DEPTH;
 		}
 		// Exit if timeout.
-		if (reply_time_ms > (reply_params -> timeout_ms)) {
+		if (reply_time_ms >= (reply_params -> timeout_ms)) {
 			// Set status to timeout if none reply has been received, otherwise the parser error code is returned.
 			if (reply_count == 0) {
 				(reply_status -> reply_timeout) = 1;
@@ -213,42 +277,35 @@ NODE_status_t _AT_BUS_wait_reply(NODE_reply_parameters_t* reply_params, NODE_rea
 			(reply_status -> sequence_timeout) = 1;
 			break;
 		}
-		IWDG_reload();
 	}
 errors:
 	return status;
 }
 
-/* PING AT NODE.
- * @param node_address:	AT address to ping.
- * @param ping_status:	Pointer to the ping operation status.
- * @return status:		Function execution status.
+/* CHECK IF A NODE SUPPORTS BURST READ.
+ * @param node_address:	Address of the node.
+ * @return:				1 if burst read can be used, 0 otherwise.
  */
-NODE_status_t _AT_BUS_ping(NODE_address_t node_address, NODE_access_status_t* ping_status) {
-	// Local variables.
-	NODE_status_t status = NODE_SUCCESS;
-	STRING_status_t string_status = STRING_SUCCESS;
-	NODE_command_parameters_t command_params;
-	NODE_reply_parameters_t reply_params;
-	NODE_read_data_t unused_read_data;
-	char_t command[AT_BUS_BUFFER_SIZE_BYTES] = {STRING_CHAR_NULL};
-	uint8_t command_size = 0;
-	// Build command structure.
-	command_params.node_address = node_address;
-	command_params.command = (char_t*) command;
-	// Build reply structure.
-	reply_params.type = NODE_REPLY_TYPE_OK;
-	reply_params.format = STRING_FORMAT_BOOLEAN;
-	reply_params.timeout_ms = AT_BUS_DEFAULT_TIMEOUT_MS;
-	reply_params.byte_array_size = 0;
-	reply_params.exact_length = 1;
-	// Build read command.
-	string_status = STRING_append_string(command, AT_BUS_BUFFER_SIZE_BYTES, AT_BUS_COMMAND_PING, &command_size);
-	STRING_status_check(NODE_ERROR_BASE_STRING);
-	// Send ping command.
-	status = AT_BUS_send_command(&command_params, &reply_params, &unused_read_data, ping_status);
-errors:
-	return status;
+static uint8_t _AT_BUS_is_burst_supported(NODE_address_t node_address) {
+	// Check address.
+	if (node_address > DINFOX_NODE_ADDRESS_LBUS_LAST) return 0;
+	return (((at_bus_ctx.burst_unsupported[node_address >> 3] & (0b1 << (node_address & 0x07))) == 0) ? 1 : 0);
+}
+
+/* STORE BURST READ CAPABILITY OF A NODE.
+ * @param node_address:	Address of the node.
+ * @param supported:	1 if burst read can be used, 0 otherwise.
+ * @return:				None.
+ */
+static void _AT_BUS_set_burst_supported(NODE_address_t node_address, uint8_t supported) {
+	// Check address.
+	if (node_address > DINFOX_NODE_ADDRESS_LBUS_LAST) return;
+	if (supported != 0) {
+		at_bus_ctx.burst_unsupported[node_address >> 3] &= ~(0b1 << (node_address & 0x07));
+	}
+	else {
+		at_bus_ctx.burst_unsupported[node_address >> 3] |= (0b1 << (node_address & 0x07));
+	}
 }
 
 /*** AT functions ***/
@@ -290,7 +347,6 @@ NODE_status_t AT_BUS_send_command(NODE_command_parameters_t* command_params, NOD
 	// Send command.
 	status = LBUS_send((command_params -> node_address), (uint8_t*) at_bus_ctx.command, at_bus_ctx.command_size);
 	if (status != NODE_SUCCESS) goto errors;
-	LPUART1_enable_rx();
 	// Wait reply.
 	status = _AT_BUS_wait_reply(reply_params, read_data, command_status);
 	if (status != NODE_SUCCESS) goto errors;
@@ -337,6 +393,125 @@ errors:
 	return status;
 }
 
+/* READ A BLOCK OF CONSECUTIVE AT BUS NODE REGISTERS.
+ * @param read_params:	Pointer to the burst read operation parameters.
+ * @param read_data:	Pointer to the registers value and status tables to fill.
+ * @return status:		Function execution status.
+ */
+NODE_status_t AT_BUS_read_registers(NODE_burst_read_parameters_t* read_params, NODE_burst_read_data_t* read_data) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	STRING_status_t string_status = STRING_SUCCESS;
+	PARSER_status_t parser_status = PARSER_SUCCESS;
+	NODE_command_parameters_t command_params;
+	NODE_reply_parameters_t reply_params;
+	NODE_read_parameters_t single_read_params;
+	NODE_read_data_t reply_data;
+	NODE_access_status_t reply_status;
+	PARSER_context_t parser;
+	char_t command[AT_BUS_BUFFER_SIZE_BYTES] = {STRING_CHAR_NULL};
+	uint8_t command_size = 0;
+	uint8_t reply_size = 0;
+	uint8_t register_address = 0;
+	uint8_t last_register_address = 0;
+	uint8_t number_of_registers = 0;
+	uint8_t separators_count = 0;
+	uint8_t idx = 0;
+	// Check parameters.
+	if ((read_params == NULL) || (read_data == NULL)) {
+		status = NODE_ERROR_NULL_PARAMETER;
+		goto errors;
+	}
+	if (((read_params -> format) == NULL) || ((read_data -> value) == NULL) || ((read_data -> status) == NULL)) {
+		status = NODE_ERROR_NULL_PARAMETER;
+		goto errors;
+	}
+	// Build command structure.
+	command_params.node_address = (read_params -> node_address);
+	command_params.command = (char_t*) command;
+	// Build reply structure (registers list is parsed locally).
+	reply_params.type = NODE_REPLY_TYPE_RAW;
+	reply_params.format = STRING_FORMAT_HEXADECIMAL;
+	reply_params.timeout_ms = (read_params -> timeout_ms);
+	reply_params.byte_array_size = 0;
+	reply_params.exact_length = 1;
+	// Configure read data.
+	reply_data.raw = NULL;
+	reply_data.value = 0;
+	reply_data.byte_array = NULL;
+	reply_data.extracted_length = 0;
+	// Single read common parameters (fallback for nodes which do not support burst read).
+	single_read_params.node_address = (read_params -> node_address);
+	single_read_params.type = NODE_REPLY_TYPE_VALUE;
+	single_read_params.timeout_ms = (read_params -> timeout_ms);
+	// Registers blocks loop.
+	last_register_address = (read_params -> register_address) + (read_params -> number_of_registers);
+	for (register_address=(read_params -> register_address) ; register_address<last_register_address ; register_address+=number_of_registers) {
+		// Compute block size (limited by the reply buffer size).
+		number_of_registers = (last_register_address - register_address);
+		if (number_of_registers > AT_BUS_BURST_READ_REGISTERS_MAX) {
+			number_of_registers = AT_BUS_BURST_READ_REGISTERS_MAX;
+		}
+		// Burst read is useless for a single register and skipped for nodes which do not support it.
+		if ((number_of_registers > 1) && (_AT_BUS_is_burst_supported(read_params -> node_address) != 0)) {
+			// Build burst read command.
+			for (idx=0 ; idx<AT_BUS_BUFFER_SIZE_BYTES ; idx++) command[idx] = STRING_CHAR_NULL;
+			command_size = 0;
+			string_status = STRING_append_string(command, AT_BUS_BUFFER_SIZE_BYTES, AT_BUS_COMMAND_READ_REGISTER, &command_size);
+			STRING_status_check(NODE_ERROR_BASE_STRING);
+			string_status = STRING_append_value(command, AT_BUS_BUFFER_SIZE_BYTES, register_address, STRING_FORMAT_HEXADECIMAL, 0, &command_size);
+			STRING_status_check(NODE_ERROR_BASE_STRING);
+			string_status = STRING_append_string(command, AT_BUS_BUFFER_SIZE_BYTES, AT_BUS_COMMAND_SEPARATOR, &command_size);
+			STRING_status_check(NODE_ERROR_BASE_STRING);
+			string_status = STRING_append_value(command, AT_BUS_BUFFER_SIZE_BYTES, number_of_registers, STRING_FORMAT_HEXADECIMAL, 0, &command_size);
+			STRING_status_check(NODE_ERROR_BASE_STRING);
+			// Send command.
+			status = AT_BUS_send_command(&command_params, &reply_params, &reply_data, &reply_status);
+			if (status != NODE_SUCCESS) goto errors;
+			// Check reply status.
+			if (reply_status.all != 0) {
+				// Node did not answer: report status on all registers of the block.
+				for (idx=0 ; idx<number_of_registers ; idx++) {
+					(read_data -> status)[register_address + idx].all = reply_status.all;
+				}
+				continue;
+			}
+			// Check reply format (one value per register).
+			string_status = STRING_get_size(reply_data.raw, &reply_size);
+			STRING_status_check(NODE_ERROR_BASE_STRING);
+			separators_count = 0;
+			for (idx=0 ; idx<reply_size ; idx++) {
+				if (reply_data.raw[idx] == AT_BUS_CHAR_SEPARATOR) separators_count++;
+			}
+			if (separators_count == (number_of_registers - 1)) {
+				// Parse registers list.
+				parser.buffer = reply_data.raw;
+				parser.buffer_size = reply_size;
+				parser.start_idx = 0;
+				parser.separator_idx = 0;
+				for (idx=0 ; idx<number_of_registers ; idx++) {
+					parser_status = PARSER_get_parameter(&parser, (read_params -> format)[register_address + idx], ((idx < (number_of_registers - 1)) ? AT_BUS_CHAR_SEPARATOR : STRING_CHAR_NULL), &((read_data -> value)[register_address + idx]));
+					if (parser_status != PARSER_SUCCESS) break;
+					(read_data -> status)[register_address + idx].all = 0;
+				}
+				if (parser_status == PARSER_SUCCESS) continue;
+			}
+			// Burst read not supported or error returned: use single register reads from now on.
+			_AT_BUS_set_burst_supported((read_params -> node_address), 0);
+		}
+		// Single register reads.
+		for (idx=0 ; idx<number_of_registers ; idx++) {
+			single_read_params.register_address = (register_address + idx);
+			single_read_params.format = (read_params -> format)[register_address + idx];
+			status = AT_BUS_read_register(&single_read_params, &reply_data, &((read_data -> status)[register_address + idx]));
+			if (status != NODE_SUCCESS) goto errors;
+			(read_data -> value)[register_address + idx] = reply_data.value;
+		}
+	}
+errors:
+	return status;
+}
+
 /* WRITE AT BUS NODE REGISTER.
  * @param write_params:	Pointer to the write operation parameters.
  * @param write_status:	Pointer to the write operation status.
@@ -380,65 +555,99 @@ errors:
 	return status;
 }
 
-/* SCAN AT BUS NODES.
- * @param nodes_list:		Node list to fill.
- * @param nodes_list_size:	Maximum size of the list.
- * @param nodes_count:		Pointer to byte that will contain the number of AT nodes detected.
- * @return status:			Function execution status.
+/* CHECK IF AN ADDRESS BELONGS TO A LEGAL AT NODE ADDRESS RANGE.
+ * @param node_address:	Address to check.
+ * @return:				1 if the address can be used by an AT node, 0 otherwise.
  */
-NODE_status_t AT_BUS_scan(NODE_t* nodes_list, uint8_t nodes_list_size, uint8_t* nodes_count) {
+uint8_t AT_BUS_is_scan_address(NODE_address_t node_address) {
+	// Local variables.
+	uint8_t idx = 0;
+	// Loop on ranges.
+	for (idx=0 ; idx<(sizeof(AT_BUS_SCAN_RANGES) / sizeof(AT_BUS_address_range_t)) ; idx++) {
+		if ((node_address >= AT_BUS_SCAN_RANGES[idx].start) && (node_address < (AT_BUS_SCAN_RANGES[idx].start + AT_BUS_SCAN_RANGES[idx].range))) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/* PROBE AN AT NODE.
+ * @param node_address:	Address to probe.
+ * @param node:			Pointer to the node structure that will contain the address and board ID if found.
+ * @param node_found:	Pointer to byte that will contain 1 if a node replied at this address, 0 otherwise.
+ * @return status:		Function execution status.
+ */
+NODE_status_t AT_BUS_probe(NODE_address_t node_address, NODE_t* node, uint8_t* node_found) {
 	// Local variables.
 	NODE_status_t status = NODE_SUCCESS;
 	NODE_read_parameters_t read_params;
 	NODE_read_data_t read_data;
 	NODE_access_status_t read_status;
-	NODE_address_t node_address = 0;
-	uint8_t node_list_idx = 0;
 	// Check parameters.
-	if ((nodes_list == NULL) || (nodes_count == NULL)) {
+	if ((node == NULL) || (node_found == NULL)) {
 		status = NODE_ERROR_NULL_PARAMETER;
 		goto errors;
 	}
-	// Reset count.
-	(*nodes_count) = 0;
-	// Build read input common parameters.
-	read_params.format = STRING_FORMAT_HEXADECIMAL;
-	read_params.timeout_ms = AT_BUS_DEFAULT_TIMEOUT_MS;
+	(*node_found) = 0;
+	// Read board ID directly: any reply (even an error) proves the node is present.
+	read_params.node_address = node_address;
 	read_params.register_address = DINFOX_REGISTER_BOARD_ID;
 	read_params.type = NODE_REPLY_TYPE_VALUE;
+	read_params.timeout_ms = AT_BUS_DEFAULT_TIMEOUT_MS;
+	read_params.format = STRING_FORMAT_HEXADECIMAL;
 	// Configure read data.
 	read_data.raw = NULL;
 	read_data.value = 0;
 	read_data.byte_array = NULL;
 	read_data.extracted_length = 0;
-	// Loop on all addresses.
-	for (node_address=0 ; node_address<=DINFOX_NODE_ADDRESS_LBUS_LAST ; node_address++) {
-		// Ping address.
-		status = _AT_BUS_ping(node_address, &read_status);
-		if (status != NODE_SUCCESS) goto errors;
-		// Check reply status.
-		if (read_status.all == 0) {
-			// Node found (even if an error was returned after ping command).
-			(*nodes_count)++;
-			// Store address and reset board ID.
-			nodes_list[node_list_idx].address = node_address;
-			nodes_list[node_list_idx].board_id = DINFOX_BOARD_ID_ERROR;
-			// Get board ID.
-			read_params.node_address = node_address;
-			status = AT_BUS_read_register(&read_params, &read_data, &read_status);
+	status = AT_BUS_read_register(&read_params, &read_data, &read_status);
+	if (status != NODE_SUCCESS) goto errors;
+	// Check reply status.
+	if ((read_status.reply_timeout == 0) && (read_status.sequence_timeout == 0)) {
+		(*node_found) = 1;
+		(node -> address) = node_address;
+		(node -> board_id) = (read_status.all == 0) ? ((uint8_t) read_data.value) : DINFOX_BOARD_ID_ERROR;
+		// Node may have been replaced: check burst read capability again.
+		_AT_BUS_set_burst_supported(node_address, 1);
+	}
+errors:
+	return status;
+}
+
+/* SCAN AT BUS NODES.
+ * @param nodes_list:		Node list to fill.
+ * @param nodes_list_size:	Maximum size of the list.
+ * @param nodes_count:		Pointer to byte that will contain the number of AT nodes detected.
+ * @return status:			Function execution status.
+ */
+NODE_status_t AT_BUS_scan(NODE_t* nodes_list, uint8_t nodes_list_size, uint8_t* nodes_count) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	NODE_address_t node_address = 0;
+	uint8_t range_idx = 0;
+	uint8_t node_found = 0;
+	// Check parameters.
+	if ((nodes_list == NULL) || (nodes_count == NULL)) {
+		status = NODE_ERROR_NULL_PARAMETER;
+		goto errors;
+	}
+	// Reset count.
+	(*nodes_count) = 0;
+	// Loop on legal address ranges only.
+	for (range_idx=0 ; range_idx<(sizeof(AT_BUS_SCAN_RANGES) / sizeof(AT_BUS_address_range_t)) ; range_idx++) {
+		for (node_address=AT_BUS_SCAN_RANGES[range_idx].start ; node_address<(AT_BUS_SCAN_RANGES[range_idx].start + AT_BUS_SCAN_RANGES[range_idx].range) ; node_address++) {
+			// Check index.
+			if ((*nodes_count) >= nodes_list_size) goto errors;
+			// Probe address.
+			status = AT_BUS_probe(node_address, &(nodes_list[*nodes_count]), &node_found);
 			if (status != NODE_SUCCESS) goto errors;
-			// Check reply status.
-			if (read_status.all == 0) {
-				// Update board ID.
-				nodes_list[node_list_idx].board_id = (uint8_t) read_data.value;
+			// Update count.
+			if (node_found != 0) {
+				(*nodes_count)++;
 			}
-			node_list_idx++;
-			// Check index.
-			if (node_list_idx >= nodes_list_size) break;
+			IWDG_reload();
 		}
-		IWDG_reload();
 	}
-	return NODE_SUCCESS;
 errors:
 	return status;
 }
@@ -452,20 +661,23 @@ void AT_BUS_fill_rx_buffer(uint8_t rx_byte) {
 	uint8_t idx = at_bus_ctx.reply[at_bus_ctx.reply_write_idx].size;
 	// Check ending characters.
 	if (rx_byte == AT_BUS_FRAME_END) {
-		// Set flag on current buffer.
+		// Close current buffer and notify main context (the flag is set here so that a full event queue can not lose the line).
 		at_bus_ctx.reply[at_bus_ctx.reply_write_idx].buffer[idx] = STRING_CHAR_NULL;
 		at_bus_ctx.reply[at_bus_ctx.reply_write_idx].line_end_flag = 1;
+		EVENT_post(EVENT_TYPE_AT_BUS_LINE_END, at_bus_ctx.reply_write_idx);
 		// Switch buffer.
 		at_bus_ctx.reply_write_idx = (at_bus_ctx.reply_write_idx + 1) % AT_BUS_REPLY_BUFFER_DEPTH;
 		// Reset LBUS layer.
 		LBUS_reset();
 	}
-	else {
-		// Store incoming byte.
+	else if (idx < (AT_BUS_BUFFER_SIZE_BYTES - 1)) {
+		// Store incoming byte (last byte is kept for the null character).
 		at_bus_ctx.reply[at_bus_ctx.reply_write_idx].buffer[idx] = rx_byte;
-		// Manage index.
-		idx = (idx + 1) % AT_BUS_BUFFER_SIZE_BYTES;
-		at_bus_ctx.reply[at_bus_ctx.reply_write_idx].size = idx;
+		at_bus_ctx.reply[at_bus_ctx.reply_write_idx].size = (idx + 1);
+	}
+	else {
+		// Drop remaining bytes and mark the line as invalid.
+		at_bus_ctx.reply[at_bus_ctx.reply_write_idx].overflow_flag = 1;
 	}
 }
 
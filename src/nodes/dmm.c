@@ -9,13 +9,22 @@
 
 #include "adc.h"
 #include "dinfox.h"
+#include "math.h"
 #include "node.h"
 #include "nvm.h"
+#include "rcc_reg.h"
 #include "string.h"
+#include "version.h"
 
 /*** DMM local macros ***/
 
 #define DMM_SIGFOX_PAYLOAD_MONITORING_SIZE		10
+#define DMM_SIGFOX_PAYLOAD_DATA_SIZE			10
+
+#define DMM_STATISTICS_NUMBER_OF_REGISTERS		4
+#define DMM_SIGFOX_PAYLOAD_STATISTICS_MIN		(-32768)
+#define DMM_SIGFOX_PAYLOAD_STATISTICS_MAX		32767
+#define DMM_SIGFOX_PAYLOAD_STDDEV_MAX			65535
 
 static const char_t* DMM_STRING_DATA_NAME[DMM_NUMBER_OF_SPECIFIC_STRING_DATA] = {
 	"VUSB =",
@@ -23,7 +32,28 @@ static const char_t* DMM_STRING_DATA_NAME[DMM_NUMBER_OF_SPECIFIC_STRING_DATA] =
 	"VHMI =",
 	"NODES_CNT =",
 	"UL_PRD = ",
-	"DL_PRD = "
+	"DL_PRD = ",
+	"DEGRADED =",
+	"SCAN_BGT = ",
+	"VUSB_MIN =",
+	"VUSB_MAX =",
+	"VUSB_MEAN =",
+	"VUSB_SDEV =",
+	"VRS_MIN =",
+	"VRS_MAX =",
+	"VRS_MEAN =",
+	"VRS_SDEV =",
+	"VHMI_MIN =",
+	"VHMI_MAX =",
+	"VHMI_MEAN =",
+	"VHMI_SDEV =",
+	"STAT_WIN = ",
+	"STAT_NODE = ",
+	"STAT_REG = ",
+	"STAT_MIN =",
+	"STAT_MAX =",
+	"STAT_MEAN =",
+	"STAT_SDEV ="
 };
 static const char_t* DMM_STRING_DATA_UNIT[DMM_NUMBER_OF_SPECIFIC_STRING_DATA] = {
 	"mV",
@@ -31,7 +61,28 @@ static const char_t* DMM_STRING_DATA_UNIT[DMM_NUMBER_OF_SPECIFIC_STRING_DATA] =
 	"mV",
 	STRING_NULL,
 	"s",
-	"s"
+	"s",
+	STRING_NULL,
+	"ms",
+	"mV",
+	"mV",
+	"mV",
+	"mV",
+	"mV",
+	"mV",
+	"mV",
+	"mV",
+	"mV",
+	"mV",
+	"mV",
+	"mV",
+	STRING_NULL,
+	STRING_NULL,
+	STRING_NULL,
+	STRING_NULL,
+	STRING_NULL,
+	STRING_NULL,
+	STRING_NULL
 };
 static const int32_t DMM_ERROR_VALUE[DMM_NUMBER_OF_SPECIFIC_REGISTERS] = {
 	NODE_ERROR_VALUE_ANALOG_16BITS,
@@ -39,6 +90,27 @@ static const int32_t DMM_ERROR_VALUE[DMM_NUMBER_OF_SPECIFIC_REGISTERS] = {
 	NODE_ERROR_VALUE_ANALOG_16BITS,
 	0,
 	0,
+	0,
+	0,
+	0,
+	NODE_ERROR_VALUE_ANALOG_16BITS,
+	NODE_ERROR_VALUE_ANALOG_16BITS,
+	NODE_ERROR_VALUE_ANALOG_16BITS,
+	NODE_ERROR_VALUE_ANALOG_16BITS,
+	NODE_ERROR_VALUE_ANALOG_16BITS,
+	NODE_ERROR_VALUE_ANALOG_16BITS,
+	NODE_ERROR_VALUE_ANALOG_16BITS,
+	NODE_ERROR_VALUE_ANALOG_16BITS,
+	NODE_ERROR_VALUE_ANALOG_16BITS,
+	NODE_ERROR_VALUE_ANALOG_16BITS,
+	NODE_ERROR_VALUE_ANALOG_16BITS,
+	NODE_ERROR_VALUE_ANALOG_16BITS,
+	0,
+	NODE_ERROR_VALUE_NODE_ADDRESS,
+	0,
+	0,
+	0,
+	0,
 	0
 };
 
@@ -60,6 +132,59 @@ typedef union {
 	} __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
 } DMM_sigfox_payload_monitoring_t;
 
+typedef union {
+	uint8_t frame[DMM_SIGFOX_PAYLOAD_DATA_SIZE];
+	struct {
+		unsigned stats_node_address : 8;
+		unsigned stats_register_address : 8;
+		signed stats_min : 16; // Saturated to the signed 16-bits range.
+		signed stats_max : 16;
+		signed stats_mean : 16;
+		unsigned stats_stddev : 16; // Saturated to the unsigned 16-bits range.
+	} __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
+} DMM_sigfox_payload_data_t;
+
+/*** DMM local functions ***/
+
+/* SATURATE A VALUE TO A PAYLOAD FIELD RANGE.
+ * @param value:	Value to saturate.
+ * @param min:		Minimum value of the field.
+ * @param max:		Maximum value of the field.
+ * @return:			Saturated value.
+ */
+static int32_t _DMM_clamp(int32_t value, int32_t min, int32_t max) {
+	// Check range.
+	if (value < min) return min;
+	if (value > max) return max;
+	return value;
+}
+
+/* GET ONE FIELD OF A STATISTICS RESULT.
+ * @param statistics:	Pointer to the statistics result.
+ * @param field_idx:	Field index (registers order: minimum, maximum, mean and standard deviation).
+ * @return:				Field value.
+ */
+static int32_t _DMM_get_statistics_field(MATH_statistics_result_t* statistics, uint8_t field_idx) {
+	// Local variables.
+	int32_t value = 0;
+	// Check index.
+	switch (field_idx % DMM_STATISTICS_NUMBER_OF_REGISTERS) {
+	case 0:
+		value = (statistics -> min);
+		break;
+	case 1:
+		value = (statistics -> max);
+		break;
+	case 2:
+		value = (statistics -> mean);
+		break;
+	default:
+		value = (int32_t) (statistics -> standard_deviation);
+		break;
+	}
+	return value;
+}
+
 /*** DMM functions ***/
 
 /* READ DMM REGISTER.
@@ -73,7 +198,11 @@ NODE_status_t DMM_read_register(NODE_read_parameters_t* read_params, NODE_read_d
 	NODE_status_t status = NODE_SUCCESS;
 	ADC_status_t adc1_status = ADC_SUCCESS;
 	STRING_status_t string_status = STRING_SUCCESS;
+	STRING_format_t register_format = STRING_FORMAT_DECIMAL;
+	MATH_statistics_result_t statistics;
+	uint8_t statistics_idx = 0;
 	uint32_t generic_u32 = 0;
+	int8_t generic_s8 = 0;
 	// Check parameters.
 	if ((read_params == NULL) || (read_data == NULL) || (read_status == NULL)) {
 		status = NODE_ERROR_NULL_PARAMETER;
@@ -84,8 +213,62 @@ NODE_status_t DMM_read_register(NODE_read_parameters_t* read_params, NODE_read_d
 		status = NODE_ERROR_NODE_ADDRESS;
 		goto errors;
 	}
+	// Reset status.
+	(*read_status).all = 0;
 	// Read register.
 	switch (read_params -> register_address) {
+	case DINFOX_REGISTER_NODE_ADDRESS:
+		(read_data -> value) = (int32_t) DINFOX_NODE_ADDRESS_DMM;
+		break;
+	case DINFOX_REGISTER_BOARD_ID:
+		(read_data -> value) = (int32_t) DINFOX_BOARD_ID_DMM;
+		break;
+	case DINFOX_REGISTER_HW_VERSION_MAJOR:
+#ifdef HW1_0
+		(read_data -> value) = (int32_t) 1;
+#else
+		(*read_status).error_received = 1;
+#endif
+		break;
+	case DINFOX_REGISTER_HW_VERSION_MINOR:
+#ifdef HW1_0
+		(read_data -> value) = (int32_t) 0;
+#else
+		(*read_status).error_received = 1;
+#endif
+		break;
+	case DINFOX_REGISTER_SW_VERSION_MAJOR:
+		(read_data -> value) = (int32_t) GIT_MAJOR_VERSION;
+		break;
+	case DINFOX_REGISTER_SW_VERSION_MINOR:
+		(read_data -> value) = (int32_t) GIT_MINOR_VERSION;
+		break;
+	case DINFOX_REGISTER_SW_VERSION_COMMIT_INDEX:
+		(read_data -> value) = (int32_t) GIT_COMMIT_INDEX;
+		break;
+	case DINFOX_REGISTER_SW_VERSION_COMMIT_ID:
+		(read_data -> value) = (int32_t) GIT_COMMIT_ID;
+		break;
+	case DINFOX_REGISTER_SW_VERSION_DIRTY_FLAG:
+		(read_data -> value) = (int32_t) GIT_DIRTY_FLAG;
+		break;
+	case DINFOX_REGISTER_RESET_REASON:
+		(read_data -> value) = (int32_t) (((RCC -> CSR) >> 24) & 0xFF);
+		break;
+	case DINFOX_REGISTER_ERROR_STACK:
+		// Error stack is not exposed as register on the master board.
+		(*read_status).error_received = 1;
+		break;
+	case DINFOX_REGISTER_TMCU_DEGREES:
+		adc1_status = ADC1_get_tmcu(&generic_s8);
+		ADC1_status_check(NODE_ERROR_BASE_ADC);
+		(read_data -> value) = (int32_t) generic_s8;
+		break;
+	case DINFOX_REGISTER_VMCU_MV:
+		adc1_status = ADC1_get_data(ADC_DATA_INDEX_VMCU_MV, &generic_u32);
+		ADC1_status_check(NODE_ERROR_BASE_ADC);
+		(read_data -> value) = (int32_t) generic_u32;
+		break;
 	case DMM_REGISTER_VUSB_MV:
 	case DMM_REGISTER_VRS_MV:
 	case DMM_REGISTER_VHMI_MV:
@@ -103,19 +286,70 @@ NODE_status_t DMM_read_register(NODE_read_parameters_t* read_params, NODE_read_d
 	case DMM_REGISTER_SIGFOX_DL_PERIOD_SECONDS:
 		(read_data -> value) = (int32_t) NODE_get_sigfox_dl_period();
 		break;
+	case DMM_REGISTER_DEGRADED_NODES_COUNT:
+		(read_data -> value) = (int32_t) NODE_get_degraded_count();
+		break;
+	case DMM_REGISTER_SCAN_BUDGET_MS:
+		(read_data -> value) = (int32_t) NODE_get_scan_budget();
+		break;
+	case DMM_REGISTER_VUSB_MIN_MV:
+	case DMM_REGISTER_VUSB_MAX_MV:
+	case DMM_REGISTER_VUSB_MEAN_MV:
+	case DMM_REGISTER_VUSB_STDDEV_MV:
+	case DMM_REGISTER_VRS_MIN_MV:
+	case DMM_REGISTER_VRS_MAX_MV:
+	case DMM_REGISTER_VRS_MEAN_MV:
+	case DMM_REGISTER_VRS_STDDEV_MV:
+	case DMM_REGISTER_VHMI_MIN_MV:
+	case DMM_REGISTER_VHMI_MAX_MV:
+	case DMM_REGISTER_VHMI_MEAN_MV:
+	case DMM_REGISTER_VHMI_STDDEV_MV:
+		// Note: indexing only works if registers addresses are ordered in the same way as ADC data indexes.
+		statistics_idx = ((read_params -> register_address) - DMM_REGISTER_VUSB_MIN_MV);
+		adc1_status = ADC1_get_statistics((ADC_DATA_INDEX_VUSB_MV + (statistics_idx / DMM_STATISTICS_NUMBER_OF_REGISTERS)), &statistics);
+		if (adc1_status == (ADC_ERROR_BASE_MATH + MATH_ERROR_UNDEFINED)) {
+			// No measurement in the current window.
+			(*read_status).error_received = 1;
+			break;
+		}
+		ADC1_status_check(NODE_ERROR_BASE_ADC);
+		(read_data -> value) = _DMM_get_statistics_field(&statistics, statistics_idx);
+		break;
+	case DMM_REGISTER_STATS_WINDOW:
+		(read_data -> value) = (int32_t) NODE_get_statistics_window();
+		break;
+	case DMM_REGISTER_STATS_NODE_ADDRESS:
+		(read_data -> value) = (int32_t) NODE_get_statistics_node_address();
+		break;
+	case DMM_REGISTER_STATS_REGISTER_ADDRESS:
+		(read_data -> value) = (int32_t) NODE_get_statistics_register_address();
+		break;
+	case DMM_REGISTER_STATS_MIN:
+	case DMM_REGISTER_STATS_MAX:
+	case DMM_REGISTER_STATS_MEAN:
+	case DMM_REGISTER_STATS_STDDEV:
+		status = NODE_get_statistics(&statistics);
+		if (status == (NODE_ERROR_BASE_MATH + MATH_ERROR_UNDEFINED)) {
+			// No read in the current window (or statistics disabled).
+			status = NODE_SUCCESS;
+			(*read_status).error_received = 1;
+			break;
+		}
+		if (status != NODE_SUCCESS) goto errors;
+		(read_data -> value) = _DMM_get_statistics_field(&statistics, ((read_params -> register_address) - DMM_REGISTER_STATS_MIN));
+		break;
 	default:
 		status = NODE_ERROR_REGISTER_ADDRESS;
 		goto errors;
 	}
 	// Convert value to string.
-	string_status = STRING_value_to_string((read_data -> value), DMM_REGISTERS_FORMAT[(read_params -> register_address) - DINFOX_REGISTER_LAST], 0, dmm_register_value_str);
+	register_format = ((read_params -> register_address) < DINFOX_REGISTER_LAST) ? DINFOX_REGISTERS_FORMAT[read_params -> register_address] : DMM_REGISTERS_FORMAT[(read_params -> register_address) - DINFOX_REGISTER_LAST];
+	string_status = STRING_value_to_string((read_data -> value), register_format, 0, dmm_register_value_str);
 	STRING_status_check(NODE_ERROR_BASE_STRING);
 	// Update raw data.
 	(read_data -> raw) = (char_t*) dmm_register_value_str;
 	(read_data -> byte_array) = NULL;
 	(read_data -> extracted_length) = 0;
-	// Update status.
-	(*read_status).all = 0;
 errors:
 	return status;
 }
@@ -128,6 +362,7 @@ errors:
 NODE_status_t DMM_write_register(NODE_write_parameters_t* write_params, NODE_access_status_t* write_status) {
 	// Local variables.
 	NODE_status_t status = NODE_SUCCESS;
+	ADC_status_t adc1_status = ADC_SUCCESS;
 	// Check parameters.
 	if ((write_params == NULL) || (write_status == NULL)) {
 		status = NODE_ERROR_NULL_PARAMETER;
@@ -152,6 +387,23 @@ NODE_status_t DMM_write_register(NODE_write_parameters_t* write_params, NODE_acc
 		status = NODE_set_sigfox_dl_period((uint32_t) (write_params -> value));
 		if (status != NODE_SUCCESS) goto errors;
 		break;
+	case DMM_REGISTER_SCAN_BUDGET_MS:
+		status = NODE_set_scan_budget((uint32_t) (write_params -> value));
+		if (status != NODE_SUCCESS) goto errors;
+		break;
+	case DMM_REGISTER_STATS_WINDOW:
+		adc1_status = ADC1_set_statistics_window((uint16_t) (write_params -> value));
+		ADC1_status_check(NODE_ERROR_BASE_ADC);
+		status = NODE_set_statistics_window((uint16_t) (write_params -> value));
+		if (status != NODE_SUCCESS) goto errors;
+		break;
+	case DMM_REGISTER_STATS_NODE_ADDRESS:
+		NODE_set_statistics_node_address((NODE_address_t) (write_params -> value));
+		break;
+	case DMM_REGISTER_STATS_REGISTER_ADDRESS:
+		status = NODE_set_statistics_register_address((uint8_t) (write_params -> value));
+		if (status != NODE_SUCCESS) goto errors;
+		break;
 	default:
 		status = NODE_ERROR_REGISTER_READ_ONLY;
 		goto errors;
@@ -169,9 +421,6 @@ errors:
 NODE_status_t DMM_update_data(NODE_data_update_t* data_update) {
 	// Local variables.
 	NODE_status_t status = NODE_SUCCESS;
-	NODE_read_parameters_t read_params;
-	NODE_read_data_t read_data;
-	NODE_access_status_t read_status;
 	STRING_status_t string_status = STRING_SUCCESS;
 	uint8_t register_address = 0;
 	uint8_t buffer_size = 0;
@@ -180,7 +429,7 @@ NODE_status_t DMM_update_data(NODE_data_update_t* data_update) {
 		status = NODE_ERROR_NULL_PARAMETER;
 		goto errors;
 	}
-	if (((data_update -> name_ptr) == NULL) || ((data_update -> value_ptr) == NULL) || ((data_update -> registers_value_ptr) == NULL)) {
+	if (((data_update -> name_ptr) == NULL) || ((data_update -> value_ptr) == NULL) || ((data_update -> registers_value_ptr) == NULL) || ((data_update -> registers_status_ptr) == NULL)) {
 		status = NODE_ERROR_NULL_PARAMETER;
 		goto errors;
 	}
@@ -191,35 +440,19 @@ NODE_status_t DMM_update_data(NODE_data_update_t* data_update) {
 	}
 	// Convert to register address.
 	register_address = ((data_update -> string_data_index) + DINFOX_REGISTER_LAST - DINFOX_STRING_DATA_INDEX_LAST);
-	// Build read parameters.
-	read_params.node_address = DINFOX_NODE_ADDRESS_DMM;
-	read_params.register_address = register_address;
-	read_params.format = STRING_FORMAT_DECIMAL;
-	read_params.timeout_ms = 0;
-	read_params.type = NODE_REPLY_TYPE_VALUE;
-	// Configure read data.
-	read_data.raw = NULL;
-	read_data.value = 0;
-	read_data.byte_array = NULL;
-	read_data.extracted_length = 0;
-	// Read register.
-	status = DMM_read_register(&read_params, &read_data, &read_status);
-	if (status != NODE_SUCCESS) goto errors;
 	// Add data name.
 	NODE_append_string_name((char_t*) DMM_STRING_DATA_NAME[(data_update -> string_data_index) - DINFOX_STRING_DATA_INDEX_LAST]);
 	buffer_size = 0;
 	// Add data value.
-	if (read_status.all == 0) {
+	if ((data_update -> registers_status_ptr)[register_address].all == 0) {
 		// Add value and unit.
-		NODE_append_string_value(read_data.raw);
+		NODE_append_string_value_int32((data_update -> registers_value_ptr)[register_address], DMM_REGISTERS_FORMAT[register_address - DINFOX_REGISTER_LAST], (DMM_REGISTERS_FORMAT[register_address - DINFOX_REGISTER_LAST] == STRING_FORMAT_HEXADECIMAL) ? 1 : 0);
 		NODE_append_string_value((char_t*) DMM_STRING_DATA_UNIT[(data_update -> string_data_index) - DINFOX_STRING_DATA_INDEX_LAST]);
-		// Update integer data.
-		NODE_update_value(register_address, read_data.value);
 	}
 	else {
 		NODE_flush_string_value();
 		NODE_append_string_value((char_t*) NODE_ERROR_STRING);
-		NODE_update_value(register_address, DMM_ERROR_VALUE[register_address]);
+		NODE_update_value(register_address, DMM_ERROR_VALUE[register_address - DINFOX_REGISTER_LAST]);
 	}
 errors:
 	return status;
@@ -236,6 +469,7 @@ NODE_status_t DMM_get_sigfox_ul_payload(int32_t* integer_data_value, NODE_sigfox
 	// Local variables.
 	NODE_status_t status = NODE_SUCCESS;
 	DMM_sigfox_payload_monitoring_t sigfox_payload_monitoring;
+	DMM_sigfox_payload_data_t sigfox_payload_data;
 	uint8_t idx = 0;
 	// Check parameters.
 	if ((integer_data_value == NULL) || (ul_payload == NULL) || (ul_payload_size == NULL)) {
@@ -259,10 +493,25 @@ NODE_status_t DMM_get_sigfox_ul_payload(int32_t* integer_data_value, NODE_sigfox
 		(*ul_payload_size) = DMM_SIGFOX_PAYLOAD_MONITORING_SIZE;
 		break;
 	case NODE_SIGFOX_PAYLOAD_TYPE_DATA:
-		// No data frame.
-		(*ul_payload_size) = 0;
-		status = NODE_ERROR_SIGFOX_PAYLOAD_EMPTY;
-		goto errors;
+		// Data frame only contains the statistics of the selected register.
+		if (integer_data_value[DMM_REGISTER_STATS_NODE_ADDRESS] == DINFOX_NODE_ADDRESS_BROADCAST) {
+			(*ul_payload_size) = 0;
+			status = NODE_ERROR_SIGFOX_PAYLOAD_EMPTY;
+			goto errors;
+		}
+		// Build data payload.
+		sigfox_payload_data.stats_node_address = integer_data_value[DMM_REGISTER_STATS_NODE_ADDRESS];
+		sigfox_payload_data.stats_register_address = integer_data_value[DMM_REGISTER_STATS_REGISTER_ADDRESS];
+		sigfox_payload_data.stats_min = _DMM_clamp(integer_data_value[DMM_REGISTER_STATS_MIN], DMM_SIGFOX_PAYLOAD_STATISTICS_MIN, DMM_SIGFOX_PAYLOAD_STATISTICS_MAX);
+		sigfox_payload_data.stats_max = _DMM_clamp(integer_data_value[DMM_REGISTER_STATS_MAX], DMM_SIGFOX_PAYLOAD_STATISTICS_MIN, DMM_SIGFOX_PAYLOAD_STATISTICS_MAX);
+		sigfox_payload_data.stats_mean = _DMM_clamp(integer_data_value[DMM_REGISTER_STATS_MEAN], DMM_SIGFOX_PAYLOAD_STATISTICS_MIN, DMM_SIGFOX_PAYLOAD_STATISTICS_MAX);
+		sigfox_payload_data.stats_stddev = _DMM_clamp(integer_data_value[DMM_REGISTER_STATS_STDDEV], 0, DMM_SIGFOX_PAYLOAD_STDDEV_MAX);
+		// Copy payload.
+		for (idx=0 ; idx<DMM_SIGFOX_PAYLOAD_DATA_SIZE ; idx++) {
+			ul_payload[idx] = sigfox_payload_data.frame[idx];
+		}
+		(*ul_payload_size) = DMM_SIGFOX_PAYLOAD_DATA_SIZE;
+		break;
 	default:
 		status = NODE_ERROR_SIGFOX_PAYLOAD_TYPE;
 		goto errors;
@@ -18,6 +18,7 @@
 // Physical interface.
 #define LBUS_DESTINATION_ADDRESS_MARKER		0x80
 #define LBUS_ADDRESS_SIZE_BYTES				1
+#define LBUS_DATA_SIZE_BYTES_MAX			64
 
 /*** LBUS local structures ***/
 
@@ -28,6 +29,7 @@ typedef enum {
 } LBUS_frame_field_index_t;
 
 typedef struct {
+	uint8_t tx_frame[LBUS_FRAME_FIELD_INDEX_DATA + LBUS_DATA_SIZE_BYTES_MAX];
 	NODE_address_t self_address;
 	NODE_address_t expected_slave_address;
 	uint8_t source_address_mismatch;
@@ -53,6 +55,8 @@ NODE_status_t _LBUS_configure_phy(void) {
 	lpuart_config.baud_rate = LBUS_BAUD_RATE;
 	lpuart_config.rx_mode = LPUART_RX_MODE_ADDRESSED;
 	lpuart_config.rx_callback = &LBUS_fill_rx_buffer;
+	// Enable receiver as soon as the frame is sent.
+	lpuart_config.tx_callback = &LPUART1_enable_rx;
 	lpuart1_status = LPUART1_configure(&lpuart_config);
 	LPUART1_status_check(NODE_ERROR_BASE_LPUART);
 errors:
@@ -83,29 +87,38 @@ NODE_status_t LBUS_send(NODE_address_t destination_address, uint8_t* data, uint3
 	// Local variables.
 	NODE_status_t status = NODE_SUCCESS;
 	LPUART_status_t lpuart1_status = LPUART_SUCCESS;
-	uint8_t lbus_header[LBUS_FRAME_FIELD_INDEX_DATA];
-	// Check address.
+	uint32_t idx = 0;
+	// Check parameters.
 	if (destination_address > LBUS_ADDRESS_LAST) {
 		status = NODE_ERROR_NODE_ADDRESS;
 		goto errors;
 	}
-	// Store destination address for next reception.
+	if (data == NULL) {
+		status = NODE_ERROR_NULL_PARAMETER;
+		goto errors;
+	}
+	if (data_size_bytes > LBUS_DATA_SIZE_BYTES_MAX) {
+		status = NODE_ERROR_LBUS_FRAME_SIZE;
+		goto errors;
+	}
+	// Store destination address and reset RX byte count for next reception.
+	// Note: this must be done before sending since the receiver is enabled under interrupt at the end of the frame.
 	lbus_ctx.expected_slave_address = destination_address;
+	lbus_ctx.rx_byte_count = 0;
 	// Build address header.
-	lbus_header[LBUS_FRAME_FIELD_INDEX_DESTINATION_ADDRESS] = (destination_address | LBUS_DESTINATION_ADDRESS_MARKER);
-	lbus_header[LBUS_FRAME_FIELD_INDEX_SOURCE_ADDRESS] = lbus_ctx.self_address;
+	lbus_ctx.tx_frame[LBUS_FRAME_FIELD_INDEX_DESTINATION_ADDRESS] = (destination_address | LBUS_DESTINATION_ADDRESS_MARKER);
+	lbus_ctx.tx_frame[LBUS_FRAME_FIELD_INDEX_SOURCE_ADDRESS] = lbus_ctx.self_address;
+	// Append data so that the whole frame is sent in a single transfer.
+	for (idx=0 ; idx<data_size_bytes ; idx++) {
+		lbus_ctx.tx_frame[LBUS_FRAME_FIELD_INDEX_DATA + idx] = data[idx];
+	}
 	// Configure physical interface.
 	status = _LBUS_configure_phy();
 	if (status != NODE_SUCCESS) goto errors;
-	// Send header.
-	lpuart1_status = LPUART1_send(lbus_header, LBUS_FRAME_FIELD_INDEX_DATA);
-	LPUART1_status_check(NODE_ERROR_BASE_LPUART);
-	// Send command.
-	lpuart1_status = LPUART1_send(data, data_size_bytes);
+	// Send frame (receiver is enabled by the transmission complete callback).
+	lpuart1_status = LPUART1_send(lbus_ctx.tx_frame, (LBUS_FRAME_FIELD_INDEX_DATA + data_size_bytes));
 	LPUART1_status_check(NODE_ERROR_BASE_LPUART);
 errors:
-	// Reset RX byte for next reception.
-	lbus_ctx.rx_byte_count = 0;
 	return status;
 }
 
@@ -7,7 +7,6 @@
 
 #include "lvrm.h"
 
-#include "at_bus.h"
 #include "dinfox.h"
 #include "string.h"
 
@@ -65,9 +64,6 @@ NODE_status_t LVRM_update_data(NODE_data_update_t* data_update) {
 	// Local variables.
 	NODE_status_t status = NODE_SUCCESS;
 	STRING_status_t string_status = STRING_SUCCESS;
-	NODE_read_parameters_t read_params;
-	NODE_read_data_t read_data;
-	NODE_access_status_t read_status;
 	uint8_t register_address = 0;
 	uint8_t buffer_size = 0;
 	// Check parameters.
@@ -75,7 +71,7 @@ NODE_status_t LVRM_update_data(NODE_data_update_t* data_update) {
 		status = NODE_ERROR_NULL_PARAMETER;
 		goto errors;
 	}
-	if (((data_update -> name_ptr) == NULL) || ((data_update -> value_ptr) == NULL) || ((data_update -> registers_value_ptr) == NULL)) {
+	if (((data_update -> name_ptr) == NULL) || ((data_update -> value_ptr) == NULL) || ((data_update -> registers_value_ptr) == NULL) || ((data_update -> registers_status_ptr) == NULL)) {
 		status = NODE_ERROR_NULL_PARAMETER;
 		goto errors;
 	}
@@ -86,41 +82,25 @@ NODE_status_t LVRM_update_data(NODE_data_update_t* data_update) {
 	}
 	// Convert to register address.
 	register_address = ((data_update -> string_data_index) + DINFOX_REGISTER_LAST - DINFOX_STRING_DATA_INDEX_LAST);
-	// Read parameters.
-	read_params.node_address = (data_update -> node_address);
-	read_params.register_address = register_address;
-	read_params.type = NODE_REPLY_TYPE_VALUE;
-	read_params.timeout_ms = AT_BUS_DEFAULT_TIMEOUT_MS;
-	read_params.format = STRING_FORMAT_DECIMAL;
-	// Configure read data.
-	read_data.raw = NULL;
-	read_data.value = 0;
-	read_data.byte_array = NULL;
-	read_data.extracted_length = 0;
-	// Read data.
-	status = AT_BUS_read_register(&read_params, &read_data, &read_status);
-	if (status != NODE_SUCCESS) goto errors;
 	// Add data name.
 	NODE_append_string_name((char_t*) LVRM_STRING_DATA_NAME[(data_update -> string_data_index) - DINFOX_STRING_DATA_INDEX_LAST]);
 	buffer_size = 0;
 	// Add data value.
-	if (read_status.all == 0) {
+	if ((data_update -> registers_status_ptr)[register_address].all == 0) {
 		// Specific print for relay.
 		if ((data_update -> string_data_index) == LVRM_STRING_DATA_INDEX_RELAY_ENABLE) {
-			NODE_append_string_value((read_data.value == 0) ? "OFF" : "ON");
+			NODE_append_string_value(((data_update -> registers_value_ptr)[register_address] == 0) ? "OFF" : "ON");
 		}
 		else {
-			NODE_append_string_value(read_data.raw);
+			NODE_append_string_value_int32((data_update -> registers_value_ptr)[register_address], LVRM_REGISTERS_FORMAT[register_address - DINFOX_REGISTER_LAST], 0);
 		}
 		// Add unit.
 		NODE_append_string_value((char_t*) LVRM_STRING_DATA_UNIT[(data_update -> string_data_index) - DINFOX_STRING_DATA_INDEX_LAST]);
-		// Update integer data.
-		NODE_update_value(register_address, read_data.value);
 	}
 	else {
 		NODE_flush_string_value();
 		NODE_append_string_value((char_t*) NODE_ERROR_STRING);
-		NODE_update_value(register_address, LVRM_ERROR_VALUE[register_address]);
+		NODE_update_value(register_address, LVRM_ERROR_VALUE[register_address - DINFOX_REGISTER_LAST]);
 	}
 errors:
 	return status;
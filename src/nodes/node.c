@@ -12,10 +12,14 @@
 #include "ddrm.h"
 #include "dmm.h"
 #include "dinfox.h"
+#include "iwdg.h"
 #include "lpuart.h"
 #include "lvrm.h"
+#include "math.h"
+#include "nvm.h"
 #include "r4s8cr.h"
 #include "rtc.h"
+#include "scheduler.h"
 #include "sm.h"
 #include "uhfm.h"
 
@@ -26,16 +30,44 @@
 
 #define NODE_SIGFOX_PAYLOAD_STARTUP_SIZE		8
 #define NODE_SIGFOX_PAYLOAD_SIZE_MAX			12
+#define NODE_SIGFOX_UL_RECORD_HEADER_SIZE		2
+#define NODE_SIGFOX_UL_RECORDS_MAX				(NODE_SIGFOX_PAYLOAD_SIZE_MAX / (NODE_SIGFOX_UL_RECORD_HEADER_SIZE + 1))
 
 #define NODE_SIGFOX_UL_PERIOD_SECONDS_MIN		60
 #define NODE_SIGFOX_UL_PERIOD_SECONDS_DEFAULT	600
 
+#define NODE_SIGFOX_UL_TYPE_STARTUP				(0b1 << NODE_SIGFOX_PAYLOAD_TYPE_STARTUP)
+#define NODE_SIGFOX_UL_TYPE_MONITORING			(0b1 << NODE_SIGFOX_PAYLOAD_TYPE_MONITORING)
+#define NODE_SIGFOX_UL_TYPE_DATA				(0b1 << NODE_SIGFOX_PAYLOAD_TYPE_DATA)
+#define NODE_SIGFOX_UL_TYPE_ALL					(NODE_SIGFOX_UL_TYPE_STARTUP | NODE_SIGFOX_UL_TYPE_MONITORING | NODE_SIGFOX_UL_TYPE_DATA)
+
+#define NODE_SIGFOX_UL_HYSTERESIS_REGISTERS_MAX	10
+
 #define NODE_SIGFOX_DL_PERIOD_SECONDS_MIN		300
 #define NODE_SIGFOX_DL_PERIOD_SECONDS_DEFAULT	21600
-
-#define NODE_SIGFOX_LOOP_MAX					100
+#define NODE_SIGFOX_DL_POLL_PERIOD_SECONDS		RTC_WAKEUP_PERIOD_SECONDS
 
 #define NODE_ACTIONS_DEPTH						10
+#define NODE_ACTION_RETRY_MAX					3
+#define NODE_ACTION_RETRY_DELAY_SECONDS			60
+
+// The cache only holds the most recently read nodes and their first registers to fit in RAM (caching the whole list would take NODES_LIST_SIZE_MAX * NODE_REGISTER_ADDRESS_MAX values, 8 kB).
+// Other nodes and registers above this limit are always read on the bus.
+#define NODE_CACHE_REGISTERS_MAX				24
+#define NODE_CACHE_DEPTH						4 // Number of nodes cached at the same time.
+#define NODE_CACHE_TTL_SECONDS_DEFAULT			120
+
+#define NODE_BACKOFF_DELAY_SECONDS_MIN			60
+#define NODE_BACKOFF_DELAY_SECONDS_MAX			3600
+#define NODE_DEGRADED_FAILURES_THRESHOLD		3
+
+#define NODE_SCAN_PERIOD_SECONDS				3600
+#define NODE_SCAN_BUDGET_MS_DEFAULT				300
+#define NODE_SCAN_BUDGET_MS_MAX					1000
+#define NODE_SCAN_PROBE_DURATION_MS_MAX			((AT_BUS_DEFAULT_TIMEOUT_MS > R4S8CR_TIMEOUT_MS) ? AT_BUS_DEFAULT_TIMEOUT_MS : R4S8CR_TIMEOUT_MS)
+#define NODE_STATISTICS_WINDOW_DEFAULT			60 // Number of reads.
+
+#define NODE_NVM_LIST_SIZE_MAX					(NVM_NODES_LIST_SIZE_BYTES / 2)
 
 /*** NODE local structures ***/
 
@@ -54,17 +86,40 @@ typedef enum {
 } NODE_downlink_operation_code_t;
 
 typedef NODE_status_t (*NODE_read_register_t)(NODE_read_parameters_t* read_params, NODE_read_data_t* read_data, NODE_access_status_t* read_status);
+typedef NODE_status_t (*NODE_read_registers_t)(NODE_burst_read_parameters_t* read_params, NODE_burst_read_data_t* read_data);
 typedef NODE_status_t (*NODE_write_register_t)(NODE_write_parameters_t* write_params, NODE_access_status_t* write_status);
 typedef NODE_status_t (*NODE_update_data_t)(NODE_data_update_t* data_update);
 typedef NODE_status_t (*NODE_get_sigfox_payload_t)(int32_t* integer_data_value, NODE_sigfox_ul_payload_type_t ul_payload_type, uint8_t* ul_payload, uint8_t* ul_payload_size);
 
 typedef struct {
 	NODE_read_register_t read_register;
+	NODE_read_registers_t read_registers;
 	NODE_write_register_t write_register;
 	NODE_update_data_t update_data;
 	NODE_get_sigfox_payload_t get_sigfox_ul_payload;
 } NODE_functions_t;
 
+typedef enum {
+	NODE_HYSTERESIS_TYPE_ABSOLUTE = 0,
+	NODE_HYSTERESIS_TYPE_RELATIVE,
+	NODE_HYSTERESIS_TYPE_LAST
+} NODE_hysteresis_type_t;
+
+typedef struct {
+	uint8_t register_address;
+	NODE_hysteresis_type_t type;
+	uint32_t threshold; // Register unit for absolute type, percent of the last transmitted value for relative type.
+} NODE_hysteresis_t;
+
+typedef struct {
+	uint8_t payload_types; // Bitmap of the payload types supported by the board.
+	uint8_t period_multiplier[NODE_SIGFOX_PAYLOAD_TYPE_LAST]; // Period of each payload type, in number of uplink periods.
+	uint8_t priority; // Used to order records with the same deadline (0 is the highest priority).
+	// Data payload is sent by exception when a hysteresis table is given (the data period is then the maximum silence duration).
+	const NODE_hysteresis_t* data_hysteresis;
+	uint8_t data_hysteresis_size;
+} NODE_sigfox_ul_schedule_t;
+
 typedef struct {
 	char_t* name;
 	NODE_protocol_t protocol;
@@ -74,14 +129,23 @@ typedef struct {
 	NODE_functions_t functions;
 } NODE_descriptor_t;
 
+typedef struct {
+	uint8_t node_index;
+	NODE_sigfox_ul_payload_type_t ul_payload_type;
+	int32_t data_reference[NODE_SIGFOX_UL_HYSTERESIS_REGISTERS_MAX]; // Monitored registers value of a data record.
+	uint16_t data_reference_mask; // Bit n is set when the monitored register n has been read successfully.
+} NODE_sigfox_ul_record_t;
+
+// Uplink payload is a sequence of records, each one made of this header followed by data_size bytes of node payload.
+// Since board ID is lower than 16, a non-zero data size field distinguishes records from the former single node frame header (address + board ID).
 typedef union {
-	uint8_t frame[UHFM_SIGFOX_UL_PAYLOAD_SIZE_MAX];
+	uint8_t frame[NODE_SIGFOX_UL_RECORD_HEADER_SIZE];
 	struct {
 		unsigned node_address : 8;
-		unsigned board_id : 8;
-		uint8_t node_data[NODE_SIGFOX_PAYLOAD_SIZE_MAX - 2];
+		unsigned data_size : 4;
+		unsigned board_id : 4;
 	} __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
-} NODE_sigfox_ul_payload_t;
+} NODE_sigfox_ul_record_header_t;
 
 typedef union {
 	uint8_t frame[NODE_SIGFOX_PAYLOAD_STARTUP_SIZE];
@@ -111,31 +175,80 @@ typedef struct {
 	uint8_t register_address;
 	int32_t register_value;
 	uint32_t timestamp_seconds;
+	uint8_t retry_count; // Number of failed write attempts.
 } NODE_action_t;
 
 typedef struct {
 	char_t string_data_name[NODE_STRING_DATA_INDEX_MAX][NODE_STRING_BUFFER_SIZE];
 	char_t string_data_value[NODE_STRING_DATA_INDEX_MAX][NODE_STRING_BUFFER_SIZE];
 	int32_t registers_value[NODE_REGISTER_ADDRESS_MAX];
+	NODE_access_status_t registers_status[NODE_REGISTER_ADDRESS_MAX];
 } NODE_data_t;
 
+typedef struct {
+	NODE_t node;
+	int32_t registers_value[NODE_CACHE_REGISTERS_MAX];
+	uint32_t timestamp_seconds; // Time of the oldest register stored since the entry became valid.
+	uint32_t valid_mask; // Bit n is set when register n has been successfully read.
+} NODE_cache_t;
+
+typedef struct {
+	uint8_t first_register_address;
+	uint8_t number_of_registers;
+} NODE_registers_range_t;
+
+typedef struct {
+	uint8_t failures_count; // Number of consecutive reads without any answer.
+	uint8_t probe_misses_count; // Number of consecutive background probes without any answer.
+	uint32_t retry_time_seconds; // Node is not polled again before this time.
+} NODE_health_t;
+
 typedef struct {
 	NODE_data_t data;
+	// Progressive data update (string data not formatted yet and registers already read).
+	uint32_t data_pending_mask;
+	uint64_t registers_read_mask;
+	uint8_t data_no_reply_flag;
+	// Registers cache of the most recently read nodes.
+	NODE_cache_t cache[NODE_CACHE_DEPTH];
+	uint32_t cache_ttl_seconds;
+	// Nodes health (indexed as nodes list).
+	NODE_health_t health[NODES_LIST_SIZE_MAX];
 	NODE_address_t uhfm_address;
+	// Background discovery.
+	NODE_address_t scan_next_address;
+	uint8_t scan_list_updated;
+	uint32_t scan_next_time_seconds;
+	uint32_t scan_budget_ms;
+	// Running statistics of one selected register.
+	NODE_address_t statistics_node_address;
+	uint8_t statistics_register_address;
+	uint16_t statistics_window;
+	MATH_statistics_t statistics;
 	// Uplink.
-	NODE_sigfox_ul_payload_t sigfox_ul_payload;
-	NODE_sigfox_ul_payload_type_t sigfox_ul_payload_type_index;
+	uint8_t sigfox_ul_payload[UHFM_SIGFOX_UL_PAYLOAD_SIZE_MAX];
 	uint8_t sigfox_ul_payload_size;
+	NODE_t* sigfox_ul_startup_node;
+	// Records of the current payload (their next transmission time is updated once the message has been sent).
+	NODE_sigfox_ul_record_t sigfox_ul_records[NODE_SIGFOX_UL_RECORDS_MAX];
+	uint8_t sigfox_ul_records_count;
 	uint32_t sigfox_ul_period_seconds;
 	uint32_t sigfox_ul_next_time_seconds;
-	uint8_t sigfox_ul_node_list_index;
+	// Next transmission time of each record (indexed as nodes list).
+	uint32_t sigfox_ul_record_time_seconds[NODES_LIST_SIZE_MAX][NODE_SIGFOX_PAYLOAD_TYPE_LAST];
+	// Last transmitted value of the registers monitored by exception (indexed as nodes list and hysteresis tables).
+	int32_t sigfox_ul_data_reference[NODES_LIST_SIZE_MAX][NODE_SIGFOX_UL_HYSTERESIS_REGISTERS_MAX];
+	uint16_t sigfox_ul_data_reference_mask[NODES_LIST_SIZE_MAX];
 	// Downlink.
 	NODE_sigfox_dl_payload_t sigfox_dl_payload;
 	uint32_t sigfox_dl_period_seconds;
 	uint32_t sigfox_dl_next_time_seconds;
-	// Write actions list.
+	uint8_t sigfox_dl_pending;
+	uint32_t sigfox_dl_poll_time_seconds;
+	uint32_t sigfox_dl_collect_time_seconds; // Downlink is not polled anymore after this time.
+	// Write actions queue (sorted by timestamp).
 	NODE_action_t actions[NODE_ACTIONS_DEPTH];
-	uint8_t actions_index;
+	uint8_t actions_count;
 } NODE_context_t;
 
 /*** NODE local global variables ***/
@@ -143,37 +256,101 @@ typedef struct {
 // Note: table is indexed with board ID.
 static const NODE_descriptor_t NODES[DINFOX_BOARD_ID_LAST] = {
 	{"LVRM", NODE_PROTOCOL_AT_BUS, LVRM_REGISTER_LAST, LVRM_STRING_DATA_INDEX_LAST, (STRING_format_t*) LVRM_REGISTERS_FORMAT,
-		{&AT_BUS_read_register, &AT_BUS_write_register, &LVRM_update_data, &LVRM_get_sigfox_ul_payload}
+		{&AT_BUS_read_register, &AT_BUS_read_registers, &AT_BUS_write_register, &LVRM_update_data, &LVRM_get_sigfox_ul_payload}
 	},
 	{"BPSM", NODE_PROTOCOL_AT_BUS, BPSM_REGISTER_LAST, BPSM_STRING_DATA_INDEX_LAST, (STRING_format_t*) BPSM_REGISTERS_FORMAT,
-		{&AT_BUS_read_register, &AT_BUS_write_register, &BPSM_update_data, &BPSM_get_sigfox_ul_payload}
+		{&AT_BUS_read_register, &AT_BUS_read_registers, &AT_BUS_write_register, &BPSM_update_data, &BPSM_get_sigfox_ul_payload}
 	},
 	{"DDRM", NODE_PROTOCOL_AT_BUS, DDRM_REGISTER_LAST, DDRM_STRING_DATA_INDEX_LAST, (STRING_format_t*) DDRM_REGISTERS_FORMAT,
-		{&AT_BUS_read_register, &AT_BUS_write_register, &DDRM_update_data, &DDRM_get_sigfox_ul_payload}
+		{&AT_BUS_read_register, &AT_BUS_read_registers, &AT_BUS_write_register, &DDRM_update_data, &DDRM_get_sigfox_ul_payload}
 	},
 	{"UHFM", NODE_PROTOCOL_AT_BUS, UHFM_REGISTER_LAST, UHFM_STRING_DATA_INDEX_LAST, (STRING_format_t*) UHFM_REGISTERS_FORMAT,
-		{&AT_BUS_read_register, &AT_BUS_write_register, &UHFM_update_data, &UHFM_get_sigfox_ul_payload}
+		{&AT_BUS_read_register, &AT_BUS_read_registers, &AT_BUS_write_register, &UHFM_update_data, &UHFM_get_sigfox_ul_payload}
 	},
 	{"GPSM", NODE_PROTOCOL_AT_BUS, 0, 0, NULL,
-		{&AT_BUS_read_register, &AT_BUS_write_register, NULL, NULL}
+		{&AT_BUS_read_register, &AT_BUS_read_registers, &AT_BUS_write_register, NULL, NULL}
 	},
 	{"SM", NODE_PROTOCOL_AT_BUS, SM_REGISTER_LAST, SM_STRING_DATA_INDEX_LAST, (STRING_format_t*) SM_REGISTERS_FORMAT,
-		{&AT_BUS_read_register, &AT_BUS_write_register, &SM_update_data, &SM_get_sigfox_ul_payload}
+		{&AT_BUS_read_register, &AT_BUS_read_registers, &AT_BUS_write_register, &SM_update_data, &SM_get_sigfox_ul_payload}
 	},
 	{"DIM", NODE_PROTOCOL_AT_BUS, 0, 0, NULL,
-		{NULL, NULL, NULL, NULL}
+		{NULL, NULL, NULL, NULL, NULL}
 	},
 	{"RRM", NODE_PROTOCOL_AT_BUS, 0, 0, NULL,
-		{&AT_BUS_read_register, &AT_BUS_write_register, NULL, NULL}
+		{&AT_BUS_read_register, &AT_BUS_read_registers, &AT_BUS_write_register, NULL, NULL}
 	},
 	{"DMM", NODE_PROTOCOL_AT_BUS, DMM_REGISTER_LAST, DMM_STRING_DATA_INDEX_LAST, (STRING_format_t*) DMM_REGISTERS_FORMAT,
-		{&DMM_read_register, &DMM_write_register, &DMM_update_data, &DMM_get_sigfox_ul_payload}
+		{&DMM_read_register, NULL, &DMM_write_register, &DMM_update_data, &DMM_get_sigfox_ul_payload}
 	},
 	{"MPMCM", NODE_PROTOCOL_AT_BUS, 0, 0, NULL,
-		{&AT_BUS_read_register, &AT_BUS_write_register, NULL, NULL}
+		{&AT_BUS_read_register, &AT_BUS_read_registers, &AT_BUS_write_register, NULL, NULL}
 	},
 	{"R4S8CR", NODE_PROTOCOL_R4S8CR, R4S8CR_REGISTER_LAST, R4S8CR_STRING_DATA_INDEX_LAST, (STRING_format_t*) R4S8CR_REGISTERS_FORMAT,
-		{&R4S8CR_read_register, &R4S8CR_write_register, &R4S8CR_update_data, &R4S8CR_get_sigfox_ul_payload}},
+		{&R4S8CR_read_register, &R4S8CR_read_registers, &R4S8CR_write_register, &R4S8CR_update_data, &R4S8CR_get_sigfox_ul_payload}},
+};
+// Note: table is indexed with DINFOX string data index.
+static const NODE_registers_range_t DINFOX_STRING_DATA_REGISTERS[DINFOX_STRING_DATA_INDEX_LAST] = {
+	{DINFOX_REGISTER_HW_VERSION_MAJOR, 2},
+	{DINFOX_REGISTER_SW_VERSION_MAJOR, 5},
+	{DINFOX_REGISTER_RESET_REASON, 1},
+	{DINFOX_REGISTER_TMCU_DEGREES, 1},
+	{DINFOX_REGISTER_VMCU_MV, 1}
+};
+static const NODE_hysteresis_t LVRM_DATA_HYSTERESIS[] = {
+	{LVRM_REGISTER_VCOM_MV, NODE_HYSTERESIS_TYPE_RELATIVE, 5},
+	{LVRM_REGISTER_VOUT_MV, NODE_HYSTERESIS_TYPE_RELATIVE, 5},
+	{LVRM_REGISTER_IOUT_UA, NODE_HYSTERESIS_TYPE_RELATIVE, 10},
+	{LVRM_REGISTER_RELAY_ENABLE, NODE_HYSTERESIS_TYPE_ABSOLUTE, 0}
+};
+static const NODE_hysteresis_t BPSM_DATA_HYSTERESIS[] = {
+	{BPSM_REGISTER_VSRC_MV, NODE_HYSTERESIS_TYPE_RELATIVE, 5},
+	{BPSM_REGISTER_VSTR_MV, NODE_HYSTERESIS_TYPE_ABSOLUTE, 100},
+	{BPSM_REGISTER_VBKP_MV, NODE_HYSTERESIS_TYPE_ABSOLUTE, 100},
+	{BPSM_REGISTER_CHARGE_ENABLE, NODE_HYSTERESIS_TYPE_ABSOLUTE, 0},
+	{BPSM_REGISTER_CHARGE_STATUS, NODE_HYSTERESIS_TYPE_ABSOLUTE, 0},
+	{BPSM_REGISTER_BACKUP_ENABLE, NODE_HYSTERESIS_TYPE_ABSOLUTE, 0}
+};
+static const NODE_hysteresis_t DDRM_DATA_HYSTERESIS[] = {
+	{DDRM_REGISTER_VIN_MV, NODE_HYSTERESIS_TYPE_RELATIVE, 5},
+	{DDRM_REGISTER_VOUT_MV, NODE_HYSTERESIS_TYPE_RELATIVE, 5},
+	{DDRM_REGISTER_IOUT_UA, NODE_HYSTERESIS_TYPE_RELATIVE, 10},
+	{DDRM_REGISTER_DC_DC_ENABLE, NODE_HYSTERESIS_TYPE_ABSOLUTE, 0}
+};
+static const NODE_hysteresis_t SM_DATA_HYSTERESIS[] = {
+	{SM_REGISTER_AIN0_MV, NODE_HYSTERESIS_TYPE_ABSOLUTE, 100},
+	{SM_REGISTER_AIN1_MV, NODE_HYSTERESIS_TYPE_ABSOLUTE, 100},
+	{SM_REGISTER_AIN2_MV, NODE_HYSTERESIS_TYPE_ABSOLUTE, 100},
+	{SM_REGISTER_AIN3_MV, NODE_HYSTERESIS_TYPE_ABSOLUTE, 100},
+	{SM_REGISTER_DIO0, NODE_HYSTERESIS_TYPE_ABSOLUTE, 0},
+	{SM_REGISTER_DIO1, NODE_HYSTERESIS_TYPE_ABSOLUTE, 0},
+	{SM_REGISTER_DIO2, NODE_HYSTERESIS_TYPE_ABSOLUTE, 0},
+	{SM_REGISTER_DIO3, NODE_HYSTERESIS_TYPE_ABSOLUTE, 0},
+	{SM_REGISTER_TAMB_DEGREES, NODE_HYSTERESIS_TYPE_ABSOLUTE, 2},
+	{SM_REGISTER_HAMB_PERCENT, NODE_HYSTERESIS_TYPE_ABSOLUTE, 5}
+};
+static const NODE_hysteresis_t R4S8CR_DATA_HYSTERESIS[] = {
+	{R4S8CR_REGISTER_RELAY_1, NODE_HYSTERESIS_TYPE_ABSOLUTE, 0},
+	{R4S8CR_REGISTER_RELAY_2, NODE_HYSTERESIS_TYPE_ABSOLUTE, 0},
+	{R4S8CR_REGISTER_RELAY_3, NODE_HYSTERESIS_TYPE_ABSOLUTE, 0},
+	{R4S8CR_REGISTER_RELAY_4, NODE_HYSTERESIS_TYPE_ABSOLUTE, 0},
+	{R4S8CR_REGISTER_RELAY_5, NODE_HYSTERESIS_TYPE_ABSOLUTE, 0},
+	{R4S8CR_REGISTER_RELAY_6, NODE_HYSTERESIS_TYPE_ABSOLUTE, 0},
+	{R4S8CR_REGISTER_RELAY_7, NODE_HYSTERESIS_TYPE_ABSOLUTE, 0},
+	{R4S8CR_REGISTER_RELAY_8, NODE_HYSTERESIS_TYPE_ABSOLUTE, 0}
+};
+// Note: table is indexed with board ID.
+static const NODE_sigfox_ul_schedule_t NODES_SIGFOX_UL_SCHEDULE[DINFOX_BOARD_ID_LAST] = {
+	{NODE_SIGFOX_UL_TYPE_ALL, {1, 4, 6}, 1, LVRM_DATA_HYSTERESIS, (sizeof(LVRM_DATA_HYSTERESIS) / sizeof(NODE_hysteresis_t))}, // LVRM.
+	{NODE_SIGFOX_UL_TYPE_ALL, {1, 4, 6}, 0, BPSM_DATA_HYSTERESIS, (sizeof(BPSM_DATA_HYSTERESIS) / sizeof(NODE_hysteresis_t))}, // BPSM.
+	{NODE_SIGFOX_UL_TYPE_ALL, {1, 4, 6}, 1, DDRM_DATA_HYSTERESIS, (sizeof(DDRM_DATA_HYSTERESIS) / sizeof(NODE_hysteresis_t))}, // DDRM.
+	{(NODE_SIGFOX_UL_TYPE_STARTUP | NODE_SIGFOX_UL_TYPE_MONITORING), {1, 4, 0}, 3, NULL, 0}, // UHFM.
+	{0, {0, 0, 0}, 3, NULL, 0}, // GPSM.
+	{NODE_SIGFOX_UL_TYPE_ALL, {1, 4, 6}, 2, SM_DATA_HYSTERESIS, (sizeof(SM_DATA_HYSTERESIS) / sizeof(NODE_hysteresis_t))}, // SM.
+	{0, {0, 0, 0}, 3, NULL, 0}, // DIM.
+	{0, {0, 0, 0}, 3, NULL, 0}, // RRM.
+	{NODE_SIGFOX_UL_TYPE_ALL, {1, 4, 6}, 3, NULL, 0}, // DMM.
+	{0, {0, 0, 0}, 3, NULL, 0}, // MPMCM.
+	{NODE_SIGFOX_UL_TYPE_DATA, {0, 0, 6}, 2, R4S8CR_DATA_HYSTERESIS, (sizeof(R4S8CR_DATA_HYSTERESIS) / sizeof(NODE_hysteresis_t))}, // R4S8CR.
 };
 static NODE_context_t node_ctx;
 
@@ -219,6 +396,20 @@ static void _NODE_flush_string_data_value(uint8_t string_data_index) {
 	}
 }
 
+/* FLUSH REGISTERS VALUE BUFFER ONLY.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _NODE_flush_registers_value(void) {
+	// Local variables.
+	uint8_t idx = 0;
+	// Reset integer data.
+	for (idx=0 ; idx<NODE_REGISTER_ADDRESS_MAX ; idx++) {
+		node_ctx.data.registers_value[idx] = 0;
+		node_ctx.data.registers_status[idx].all = 0;
+	}
+}
+
 /* FLUSH WHOLE DATAS VALUE BUFFER.
  * @param:	None.
  * @return:	None.
@@ -228,7 +419,28 @@ void _NODE_flush_all_data_value(void) {
 	uint8_t idx = 0;
 	// Reset string and integer data.
 	for (idx=0 ; idx<NODE_STRING_DATA_INDEX_MAX ; idx++) _NODE_flush_string_data_value(idx);
-	for (idx=0 ; idx<NODE_REGISTER_ADDRESS_MAX ; idx++) node_ctx.data.registers_value[idx] = 0;
+	_NODE_flush_registers_value();
+}
+
+/* RESET ONE ENTRY OF THE NODES LIST.
+ * @param list_idx:	Index of the entry to reset.
+ * @return:			None.
+ */
+static void _NODE_reset_list_entry(uint8_t list_idx) {
+	// Local variables.
+	uint8_t type_idx = 0;
+	// Reset node and its context.
+	NODES_LIST.list[list_idx].address = 0xFF;
+	NODES_LIST.list[list_idx].board_id = DINFOX_BOARD_ID_ERROR;
+	NODES_LIST.list[list_idx].startup_data_sent = 0;
+	node_ctx.health[list_idx].failures_count = 0;
+	node_ctx.health[list_idx].probe_misses_count = 0;
+	node_ctx.health[list_idx].retry_time_seconds = 0;
+	node_ctx.sigfox_ul_data_reference_mask[list_idx] = 0;
+	// New nodes are scheduled as soon as possible.
+	for (type_idx=0 ; type_idx<NODE_SIGFOX_PAYLOAD_TYPE_LAST ; type_idx++) {
+		node_ctx.sigfox_ul_record_time_seconds[list_idx][type_idx] = 0;
+	}
 }
 
 /* FLUSH NODES LIST.
@@ -240,11 +452,434 @@ void _NODE_flush_list(void) {
 	uint8_t idx = 0;
 	// Reset node list.
 	for (idx=0 ; idx<NODES_LIST_SIZE_MAX ; idx++) {
-		NODES_LIST.list[idx].address = 0xFF;
-		NODES_LIST.list[idx].board_id = DINFOX_BOARD_ID_ERROR;
-		NODES_LIST.list[idx].startup_data_sent = 0;
+		_NODE_reset_list_entry(idx);
 	}
 	NODES_LIST.count = 0;
+	// Reset cache.
+	for (idx=0 ; idx<NODE_CACHE_DEPTH ; idx++) {
+		node_ctx.cache[idx].valid_mask = 0;
+	}
+}
+
+/* GET INDEX OF A NODE IN LIST.
+ * @param node:		Node to search.
+ * @return idx:		Index of the node in list, NODES_LIST_SIZE_MAX if the node is not in list.
+ */
+static uint8_t _NODE_get_list_index(NODE_t* node) {
+	// Local variables.
+	uint8_t idx = 0;
+	// Search node in list (nodes may be given as a copy of the list entry).
+	for (idx=0 ; idx<NODES_LIST.count ; idx++) {
+		if ((NODES_LIST.list[idx].address == (node -> address)) && (NODES_LIST.list[idx].board_id == (node -> board_id))) return idx;
+	}
+	return NODES_LIST_SIZE_MAX;
+}
+
+/* GET CACHE INDEX OF A NODE.
+ * @param node:		Node to search.
+ * @return idx:		Index of the node cache, NODE_CACHE_DEPTH if the node is not cached.
+ */
+static uint8_t _NODE_get_cache_index(NODE_t* node) {
+	// Local variables.
+	uint8_t idx = 0;
+	// Search node in cache.
+	for (idx=0 ; idx<NODE_CACHE_DEPTH ; idx++) {
+		if ((node_ctx.cache[idx].valid_mask != 0) && (node_ctx.cache[idx].node.address == (node -> address)) && (node_ctx.cache[idx].node.board_id == (node -> board_id))) return idx;
+	}
+	return NODE_CACHE_DEPTH;
+}
+
+/* STORE A RANGE OF CURRENT REGISTERS IN NODE CACHE.
+ * @param node:						Node to cache.
+ * @param first_register_address:	Address of the first register to store.
+ * @param number_of_registers:		Number of registers to store.
+ * @return:							None.
+ */
+static void _NODE_cache_store(NODE_t* node, uint8_t first_register_address, uint8_t number_of_registers) {
+	// Local variables.
+	uint8_t cache_idx = 0;
+	uint8_t idx = 0;
+	// Restart a new entry if the node is not cached or if the previous one has expired.
+	cache_idx = _NODE_get_cache_index(node);
+	if ((cache_idx >= NODE_CACHE_DEPTH) || ((RTC_get_time_seconds() - node_ctx.cache[cache_idx].timestamp_seconds) >= node_ctx.cache_ttl_seconds)) {
+		// Replace a free entry or the oldest one.
+		if (cache_idx >= NODE_CACHE_DEPTH) {
+			cache_idx = 0;
+			for (idx=0 ; idx<NODE_CACHE_DEPTH ; idx++) {
+				if (node_ctx.cache[idx].valid_mask == 0) {
+					cache_idx = idx;
+					break;
+				}
+				if (node_ctx.cache[idx].timestamp_seconds < node_ctx.cache[cache_idx].timestamp_seconds) {
+					cache_idx = idx;
+				}
+			}
+		}
+		node_ctx.cache[cache_idx].node.address = (node -> address);
+		node_ctx.cache[cache_idx].node.board_id = (node -> board_id);
+		node_ctx.cache[cache_idx].valid_mask = 0;
+		node_ctx.cache[cache_idx].timestamp_seconds = RTC_get_time_seconds();
+	}
+	// Copy registers which have been successfully read (failed registers must be read again on next access).
+	for (idx=first_register_address ; (idx<(first_register_address + number_of_registers)) && (idx<NODE_CACHE_REGISTERS_MAX) ; idx++) {
+		if (node_ctx.data.registers_status[idx].all == 0) {
+			node_ctx.cache[cache_idx].registers_value[idx] = node_ctx.data.registers_value[idx];
+			node_ctx.cache[cache_idx].valid_mask |= ((uint32_t) 0b1 << idx);
+		}
+		else {
+			node_ctx.cache[cache_idx].valid_mask &= ~((uint32_t) 0b1 << idx);
+		}
+	}
+}
+
+/* LOAD A RANGE OF REGISTERS FROM NODE CACHE IF THEY ARE STILL FRESH.
+ * @param node:						Node to read.
+ * @param first_register_address:	Address of the first register to load.
+ * @param number_of_registers:		Number of registers to load.
+ * @return:							1 if all registers of the range were loaded from cache, 0 otherwise.
+ */
+static uint8_t _NODE_cache_load(NODE_t* node, uint8_t first_register_address, uint8_t number_of_registers) {
+	// Local variables.
+	uint8_t cache_idx = _NODE_get_cache_index(node);
+	uint8_t idx = 0;
+	// Check index and age.
+	if (cache_idx >= NODE_CACHE_DEPTH) return 0;
+	if ((RTC_get_time_seconds() - node_ctx.cache[cache_idx].timestamp_seconds) >= node_ctx.cache_ttl_seconds) return 0;
+	// Check that the whole range is available.
+	if ((first_register_address + number_of_registers) > NODE_CACHE_REGISTERS_MAX) return 0;
+	for (idx=first_register_address ; idx<(first_register_address + number_of_registers) ; idx++) {
+		if ((node_ctx.cache[cache_idx].valid_mask & ((uint32_t) 0b1 << idx)) == 0) return 0;
+	}
+	// Copy registers.
+	for (idx=first_register_address ; idx<(first_register_address + number_of_registers) ; idx++) {
+		node_ctx.data.registers_value[idx] = node_ctx.cache[cache_idx].registers_value[idx];
+		node_ctx.data.registers_status[idx].all = 0;
+	}
+	return 1;
+}
+
+/* INVALIDATE NODE CACHE.
+ * @param node:		Node to invalidate.
+ * @return:			None.
+ */
+static void _NODE_cache_invalidate(NODE_t* node) {
+	// Local variables.
+	uint8_t cache_idx = _NODE_get_cache_index(node);
+	// Check index.
+	if (cache_idx < NODE_CACHE_DEPTH) {
+		node_ctx.cache[cache_idx].valid_mask = 0;
+	}
+}
+
+/* CHECK IF A NODE IS IN BACKOFF AFTER CONSECUTIVE READ FAILURES.
+ * @param node:		Node to check.
+ * @return:			1 if the node must not be polled yet, 0 otherwise.
+ */
+static uint8_t _NODE_is_backoff_running(NODE_t* node) {
+	// Local variables.
+	uint8_t list_idx = _NODE_get_list_index(node);
+	// Check index.
+	if (list_idx >= NODES_LIST_SIZE_MAX) return 0;
+	if (node_ctx.health[list_idx].failures_count == 0) return 0;
+	return ((RTC_get_time_seconds() < node_ctx.health[list_idx].retry_time_seconds) ? 1 : 0);
+}
+
+/* UPDATE NODE HEALTH AFTER A READ OPERATION.
+ * @param node:						Node which has been read.
+ * @param first_register_address:	Address of the first register read.
+ * @param number_of_registers:		Number of registers read.
+ * @return:							None.
+ */
+static void _NODE_update_health(NODE_t* node, uint8_t first_register_address, uint8_t number_of_registers) {
+	// Local variables.
+	uint8_t list_idx = _NODE_get_list_index(node);
+	uint32_t backoff_delay_seconds = NODE_BACKOFF_DELAY_SECONDS_MIN;
+	uint8_t idx = 0;
+	// Check index.
+	if ((list_idx >= NODES_LIST_SIZE_MAX) || (number_of_registers == 0)) return;
+	// Node is alive as soon as one register has been answered.
+	for (idx=first_register_address ; idx<(first_register_address + number_of_registers) ; idx++) {
+		if ((node_ctx.data.registers_status[idx].reply_timeout == 0) && (node_ctx.data.registers_status[idx].sequence_timeout == 0)) {
+			node_ctx.health[list_idx].failures_count = 0;
+			return;
+		}
+	}
+	// Update failures count.
+	if (node_ctx.health[list_idx].failures_count < 0xFF) {
+		node_ctx.health[list_idx].failures_count++;
+	}
+	// Compute exponential backoff delay.
+	for (idx=1 ; idx<(node_ctx.health[list_idx].failures_count) ; idx++) {
+		backoff_delay_seconds <<= 1;
+		if (backoff_delay_seconds >= NODE_BACKOFF_DELAY_SECONDS_MAX) {
+			backoff_delay_seconds = NODE_BACKOFF_DELAY_SECONDS_MAX;
+			break;
+		}
+	}
+	node_ctx.health[list_idx].retry_time_seconds = RTC_get_time_seconds() + backoff_delay_seconds;
+}
+
+/* ADD SELECTED REGISTER TO THE RUNNING STATISTICS AFTER A READ OPERATION.
+ * @param node:						Node which has been read.
+ * @param first_register_address:	Address of the first register read.
+ * @param number_of_registers:		Number of registers read.
+ * @return:							None.
+ */
+static void _NODE_update_statistics(NODE_t* node, uint8_t first_register_address, uint8_t number_of_registers) {
+	// Check node and register.
+	if ((node -> address) != node_ctx.statistics_node_address) return;
+	if ((node_ctx.statistics_register_address < first_register_address) || (node_ctx.statistics_register_address >= (first_register_address + number_of_registers))) return;
+	if (node_ctx.data.registers_status[node_ctx.statistics_register_address].all != 0) return;
+	// Start a new window when the current one is complete.
+	if (node_ctx.statistics.count >= node_ctx.statistics_window) {
+		MATH_statistics_reset(&node_ctx.statistics);
+	}
+	MATH_statistics_add(&node_ctx.statistics, node_ctx.data.registers_value[node_ctx.statistics_register_address]);
+}
+
+/* SEARCH UHFM BOARD IN NODES LIST.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _NODE_update_uhfm_address(void) {
+	// Local variables.
+	uint8_t idx = 0;
+	// Reset address.
+	node_ctx.uhfm_address = DINFOX_NODE_ADDRESS_BROADCAST;
+	// Nodes loop.
+	for (idx=0 ; idx<NODES_LIST.count ; idx++) {
+		// Check board ID.
+		if (NODES_LIST.list[idx].board_id == DINFOX_BOARD_ID_UHFM) {
+			node_ctx.uhfm_address = NODES_LIST.list[idx].address;
+			break;
+		}
+	}
+}
+
+/* GET INDEX OF AN ADDRESS IN NODES LIST.
+ * @param node_address:	Address to search.
+ * @return idx:			Index of the node in list, NODES_LIST_SIZE_MAX if the address is unknown.
+ */
+static uint8_t _NODE_get_address_index(NODE_address_t node_address) {
+	// Local variables.
+	uint8_t idx = 0;
+	// Nodes loop.
+	for (idx=0 ; idx<NODES_LIST.count ; idx++) {
+		if (NODES_LIST.list[idx].address == node_address) return idx;
+	}
+	return NODES_LIST_SIZE_MAX;
+}
+
+/* CHECK IF AN ADDRESS IS ALREADY IN NODES LIST.
+ * @param node_address:	Address to search.
+ * @return:				1 if the address is already in the list, 0 otherwise.
+ */
+static uint8_t _NODE_is_known_address(NODE_address_t node_address) {
+	return ((_NODE_get_address_index(node_address) < NODES_LIST_SIZE_MAX) ? 1 : 0);
+}
+
+/* CHECK IF AN ADDRESS CAN BE USED BY A NODE.
+ * @param node_address:	Address to check.
+ * @return:				1 if the address belongs to a legal AT or R4S8CR range, 0 otherwise.
+ */
+static uint8_t _NODE_is_scan_address(NODE_address_t node_address) {
+	// R4S8CR range.
+	if ((node_address >= DINFOX_NODE_ADDRESS_R4S8CR_START) && (node_address < (DINFOX_NODE_ADDRESS_R4S8CR_START + DINFOX_NODE_ADDRESS_RANGE_R4S8CR))) return 1;
+	// AT ranges.
+	return AT_BUS_is_scan_address(node_address);
+}
+
+/* PROBE A NODE WITH THE PROTOCOL CORRESPONDING TO ITS ADDRESS.
+ * @param node_address:	Address to probe.
+ * @param node:			Pointer to the node structure that will contain the address and board ID if found.
+ * @param node_found:	Pointer to byte that will contain 1 if a node replied at this address, 0 otherwise.
+ * @return status:		Function execution status.
+ */
+static NODE_status_t _NODE_probe(NODE_address_t node_address, NODE_t* node, uint8_t* node_found) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	// Check address range.
+	if ((node_address >= DINFOX_NODE_ADDRESS_R4S8CR_START) && (node_address < (DINFOX_NODE_ADDRESS_R4S8CR_START + DINFOX_NODE_ADDRESS_RANGE_R4S8CR))) {
+		status = R4S8CR_probe(node_address, node, node_found);
+	}
+	else if (AT_BUS_is_scan_address(node_address) != 0) {
+		status = AT_BUS_probe(node_address, node, node_found);
+	}
+	else {
+		// Address can not be used by any node.
+		(*node_found) = 0;
+	}
+	return status;
+}
+
+/* SAVE NODES LIST IN NVM.
+ * @param:			None.
+ * @return status:	Function execution status.
+ */
+static NODE_status_t _NODE_save_list(void) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	NVM_status_t nvm_status = NVM_SUCCESS;
+	uint8_t nvm_nodes_count = 0;
+	uint8_t nvm_byte = 0;
+	uint8_t idx = 0;
+	// Master board is not stored.
+	nvm_nodes_count = (NODES_LIST.count > 0) ? (NODES_LIST.count - 1) : 0;
+	if (nvm_nodes_count > NODE_NVM_LIST_SIZE_MAX) {
+		nvm_nodes_count = NODE_NVM_LIST_SIZE_MAX;
+	}
+	// Write only modified bytes to limit EEPROM wear.
+	for (idx=0 ; idx<nvm_nodes_count ; idx++) {
+		// Node address.
+		nvm_status = NVM_read_byte((NVM_ADDRESS_NODES_LIST + (idx << 1)), &nvm_byte);
+		NVM_status_check(NODE_ERROR_BASE_NVM);
+		if (nvm_byte != NODES_LIST.list[idx + 1].address) {
+			nvm_status = NVM_write_byte((NVM_ADDRESS_NODES_LIST + (idx << 1)), NODES_LIST.list[idx + 1].address);
+			NVM_status_check(NODE_ERROR_BASE_NVM);
+		}
+		// Board ID.
+		nvm_status = NVM_read_byte((NVM_ADDRESS_NODES_LIST + (idx << 1) + 1), &nvm_byte);
+		NVM_status_check(NODE_ERROR_BASE_NVM);
+		if (nvm_byte != NODES_LIST.list[idx + 1].board_id) {
+			nvm_status = NVM_write_byte((NVM_ADDRESS_NODES_LIST + (idx << 1) + 1), NODES_LIST.list[idx + 1].board_id);
+			NVM_status_check(NODE_ERROR_BASE_NVM);
+		}
+	}
+	// Write count last so that an interrupted save is detected as a shorter list.
+	nvm_status = NVM_read_byte(NVM_ADDRESS_NODES_LIST_COUNT, &nvm_byte);
+	NVM_status_check(NODE_ERROR_BASE_NVM);
+	if (nvm_byte != nvm_nodes_count) {
+		nvm_status = NVM_write_byte(NVM_ADDRESS_NODES_LIST_COUNT, nvm_nodes_count);
+		NVM_status_check(NODE_ERROR_BASE_NVM);
+	}
+errors:
+	return status;
+}
+
+/* REMOVE A NODE WHICH VANISHED FROM THE BUS.
+ * @param list_idx:	Index of the node to remove.
+ * @return:			None.
+ */
+static void _NODE_retire(uint8_t list_idx) {
+	// Local variables.
+	NODE_t* retired_node = &(NODES_LIST.list[list_idx]);
+	uint8_t actions_count = 0;
+	uint8_t idx = 0;
+	uint8_t sub_idx = 0;
+	// Cached registers are not valid anymore.
+	_NODE_cache_invalidate(retired_node);
+	// Drop pending actions of the node and update pointers to the following nodes (queue order is kept).
+	for (idx=0 ; idx<node_ctx.actions_count ; idx++) {
+		if (node_ctx.actions[idx].node == retired_node) continue;
+		if (node_ctx.actions[idx].node > retired_node) {
+			node_ctx.actions[idx].node--;
+		}
+		node_ctx.actions[actions_count++] = node_ctx.actions[idx];
+	}
+	for (idx=actions_count ; idx<node_ctx.actions_count ; idx++) {
+		node_ctx.actions[idx].node = NULL;
+	}
+	node_ctx.actions_count = actions_count;
+	// Shift following nodes and their context.
+	for (idx=list_idx ; idx<(NODES_LIST.count - 1) ; idx++) {
+		NODES_LIST.list[idx] = NODES_LIST.list[idx + 1];
+		node_ctx.health[idx] = node_ctx.health[idx + 1];
+		for (sub_idx=0 ; sub_idx<NODE_SIGFOX_PAYLOAD_TYPE_LAST ; sub_idx++) {
+			node_ctx.sigfox_ul_record_time_seconds[idx][sub_idx] = node_ctx.sigfox_ul_record_time_seconds[idx + 1][sub_idx];
+		}
+		for (sub_idx=0 ; sub_idx<NODE_SIGFOX_UL_HYSTERESIS_REGISTERS_MAX ; sub_idx++) {
+			node_ctx.sigfox_ul_data_reference[idx][sub_idx] = node_ctx.sigfox_ul_data_reference[idx + 1][sub_idx];
+		}
+		node_ctx.sigfox_ul_data_reference_mask[idx] = node_ctx.sigfox_ul_data_reference_mask[idx + 1];
+	}
+	NODES_LIST.count--;
+	_NODE_reset_list_entry(NODES_LIST.count);
+}
+
+/* PROBE A SLICE OF THE ADDRESS SPACE TO DISCOVER NEW NODES AND RETIRE VANISHED ONES.
+ * @param:			None.
+ * @return status:	Function execution status.
+ */
+static NODE_status_t _NODE_background_scan(void) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	NODE_t node;
+	uint32_t probes_duration_ms = 0;
+	uint8_t list_idx = 0;
+	uint8_t node_found = 0;
+	uint8_t list_changed = 0;
+	// Check if discovery is enabled and if a slice is due (one slice per RTC wake-up during a sweep).
+	if (node_ctx.scan_budget_ms < NODE_SCAN_PROBE_DURATION_MS_MAX) goto errors;
+	if (RTC_get_time_seconds() < node_ctx.scan_next_time_seconds) goto errors;
+	// Start a new sweep periodically.
+	if (node_ctx.scan_next_address >= DINFOX_NODE_ADDRESS_BROADCAST) {
+		node_ctx.scan_next_address = 0;
+	}
+	// Probe addresses as long as the worst case duration fits in the time budget.
+	// Sweep is suspended at the next address when a higher priority task is ready.
+	while ((node_ctx.scan_next_address < DINFOX_NODE_ADDRESS_BROADCAST) && ((probes_duration_ms + NODE_SCAN_PROBE_DURATION_MS_MAX) <= node_ctx.scan_budget_ms) && (SCHEDULER_is_preemption_requested() == 0)) {
+		list_idx = _NODE_get_address_index(node_ctx.scan_next_address);
+		// Skip illegal addresses and master board without any bus access.
+		if ((_NODE_is_scan_address(node_ctx.scan_next_address) == 0) || (list_idx == 0)) {
+			node_ctx.scan_next_address++;
+			continue;
+		}
+		status = _NODE_probe(node_ctx.scan_next_address, &node, &node_found);
+		if (status != NODE_SUCCESS) goto errors;
+		probes_duration_ms += NODE_SCAN_PROBE_DURATION_MS_MAX;
+		// Check known node.
+		if (list_idx < NODES_LIST_SIZE_MAX) {
+			if ((node_found != 0) && (node.board_id == NODES_LIST.list[list_idx].board_id)) {
+				// Node is still present.
+				node_ctx.health[list_idx].failures_count = 0;
+				node_ctx.health[list_idx].probe_misses_count = 0;
+			}
+			else if (node_found != 0) {
+				// Another board replaced the node.
+				_NODE_retire(list_idx);
+				list_changed = 1;
+			}
+			else {
+				// Retire node only after several consecutive probe misses (read failures are counted separately by backoff).
+				if (node_ctx.health[list_idx].probe_misses_count < 0xFF) {
+					node_ctx.health[list_idx].probe_misses_count++;
+				}
+				if (node_ctx.health[list_idx].probe_misses_count >= NODE_DEGRADED_FAILURES_THRESHOLD) {
+					_NODE_retire(list_idx);
+					list_changed = 1;
+				}
+			}
+		}
+		// Append new node.
+		if ((node_found != 0) && (_NODE_is_known_address(node_ctx.scan_next_address) == 0) && (NODES_LIST.count < NODES_LIST_SIZE_MAX)) {
+			NODES_LIST.list[NODES_LIST.count].address = node.address;
+			NODES_LIST.list[NODES_LIST.count].board_id = node.board_id;
+			NODES_LIST.count++;
+			list_changed = 1;
+		}
+		node_ctx.scan_next_address++;
+		IWDG_reload();
+	}
+	// Apply list changes.
+	if (list_changed != 0) {
+		node_ctx.scan_list_updated = 1;
+		_NODE_update_uhfm_address();
+		// Report nodes count in next uplink (new nodes are scheduled as soon as possible with their startup record).
+		node_ctx.sigfox_ul_record_time_seconds[0][NODE_SIGFOX_PAYLOAD_TYPE_MONITORING] = 0;
+	}
+	// Continue sweep at next RTC wake-up.
+	node_ctx.scan_next_time_seconds = RTC_get_time_seconds() + RTC_WAKEUP_PERIOD_SECONDS;
+	// Check end of sweep.
+	if (node_ctx.scan_next_address >= DINFOX_NODE_ADDRESS_BROADCAST) {
+		node_ctx.scan_next_time_seconds = RTC_get_time_seconds() + NODE_SCAN_PERIOD_SECONDS;
+		// Save list if it changed.
+		if (node_ctx.scan_list_updated != 0) {
+			node_ctx.scan_list_updated = 0;
+			status = _NODE_save_list();
+		}
+	}
+errors:
+	return status;
 }
 
 /* WRITE NODE DATA.
@@ -296,35 +931,112 @@ NODE_status_t _NODE_write_register(NODE_t* node, uint8_t register_address, int32
 		break;
 	}
 	status = NODES[node -> board_id].functions.write_register(&write_input, write_status);
+	// Cached registers are not valid anymore.
+	_NODE_cache_invalidate(node);
 errors:
 	return status;
 }
 
-/* SEND NODE DATA THROUGH RADIO.
- * @param node:					Node to monitor by radio.
- * @param sigfox_payload_type:	Type of data to send.
- * @param bidirectional_flag:	Downlink request flag.
- * @return status:				Function execution status.
+/* READ A RANGE OF NODE REGISTERS.
+ * @param node:						Node to read.
+ * @param first_register_address:	Address of the first register to read.
+ * @param number_of_registers:		Number of registers to read.
+ * @return status:					Function execution status.
+ */
+NODE_status_t _NODE_read_registers(NODE_t* node, uint8_t first_register_address, uint8_t number_of_registers) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	NODE_burst_read_parameters_t read_params;
+	NODE_burst_read_data_t read_data;
+	NODE_read_parameters_t single_read_params;
+	NODE_read_data_t single_read_data;
+	STRING_format_t registers_format[NODE_REGISTER_ADDRESS_MAX];
+	uint8_t register_address = 0;
+	// Check node and board ID.
+	_NODE_check_node_and_board_id();
+	_NODE_check_function_pointer(read_register);
+	// Check range.
+	if ((first_register_address + number_of_registers) > (NODES[node -> board_id].last_register_address)) {
+		status = NODE_ERROR_REGISTER_ADDRESS;
+		goto errors;
+	}
+	// Build registers format table.
+	for (register_address=0 ; register_address<(NODES[node -> board_id].last_register_address) ; register_address++) {
+		if ((NODES[node -> board_id].protocol == NODE_PROTOCOL_AT_BUS) && (register_address < DINFOX_REGISTER_LAST)) {
+			registers_format[register_address] = DINFOX_REGISTERS_FORMAT[register_address];
+		}
+		else {
+			registers_format[register_address] = NODES[node -> board_id].registers_format[register_address - ((NODES[node -> board_id].protocol == NODE_PROTOCOL_AT_BUS) ? DINFOX_REGISTER_LAST : 0)];
+		}
+	}
+	// Common parameters.
+	read_params.node_address = (node -> address);
+	read_params.register_address = first_register_address;
+	read_params.number_of_registers = number_of_registers;
+	read_params.timeout_ms = (NODES[node -> board_id].protocol == NODE_PROTOCOL_R4S8CR) ? R4S8CR_TIMEOUT_MS : AT_BUS_DEFAULT_TIMEOUT_MS;
+	read_params.format = (STRING_format_t*) registers_format;
+	read_data.value = (int32_t*) node_ctx.data.registers_value;
+	read_data.status = (NODE_access_status_t*) node_ctx.data.registers_status;
+	// Use burst read if supported by the node.
+	if (NODES[node -> board_id].functions.read_registers != NULL) {
+		status = NODES[node -> board_id].functions.read_registers(&read_params, &read_data);
+		if (status != NODE_SUCCESS) goto errors;
+		_NODE_update_health(node, first_register_address, number_of_registers);
+		_NODE_update_statistics(node, first_register_address, number_of_registers);
+		goto errors;
+	}
+	// Otherwise read registers one by one.
+	single_read_params.node_address = (node -> address);
+	single_read_params.type = NODE_REPLY_TYPE_VALUE;
+	single_read_params.timeout_ms = read_params.timeout_ms;
+	single_read_data.raw = NULL;
+	single_read_data.value = 0;
+	single_read_data.byte_array = NULL;
+	single_read_data.extracted_length = 0;
+	for (register_address=first_register_address ; register_address<(first_register_address + number_of_registers) ; register_address++) {
+		single_read_params.register_address = register_address;
+		single_read_params.format = registers_format[register_address];
+		status = NODES[node -> board_id].functions.read_register(&single_read_params, &single_read_data, &(node_ctx.data.registers_status[register_address]));
+		if (status != NODE_SUCCESS) goto errors;
+		node_ctx.data.registers_value[register_address] = single_read_data.value;
+	}
+	_NODE_update_health(node, first_register_address, number_of_registers);
+	_NODE_update_statistics(node, first_register_address, number_of_registers);
+errors:
+	return status;
+}
+
+/* FLUSH SIGFOX UPLINK PAYLOAD.
+ * @param:	None.
+ * @return:	None.
+ */
+void _NODE_flush_ul_payload(void) {
+	// Local variables.
+	uint8_t idx = 0;
+	// Reset payload.
+	for (idx=0 ; idx<NODE_SIGFOX_PAYLOAD_SIZE_MAX ; idx++) node_ctx.sigfox_ul_payload[idx] = 0x00;
+	node_ctx.sigfox_ul_payload_size = 0;
+	node_ctx.sigfox_ul_startup_node = NULL;
+	node_ctx.sigfox_ul_records_count = 0;
+}
+
+/* ADD NODE RECORD TO SIGFOX UPLINK PAYLOAD.
+ * @param node:				Node to monitor by radio.
+ * @param ul_payload_type:	Type of data to add.
+ * @return status:			Function execution status.
  */
-NODE_status_t _NODE_radio_send(NODE_t* node, NODE_sigfox_ul_payload_type_t ul_payload_type, uint8_t bidirectional_flag) {
+NODE_status_t _NODE_add_ul_record(NODE_t* node, NODE_sigfox_ul_payload_type_t ul_payload_type) {
 	// Local variables.
 	NODE_status_t status = NODE_SUCCESS;
-	uint8_t sigfox_payload_specific_size;
+	NODE_sigfox_ul_record_header_t record_header;
 	NODE_sigfox_payload_startup_t sigfox_payload_startup;
-	UHFM_sigfox_message_t sigfox_message;
-	NODE_access_status_t send_status;
+	uint8_t record_data[NODE_SIGFOX_PAYLOAD_SIZE_MAX];
+	uint8_t record_data_size = 0;
 	uint8_t idx = 0;
 	// Check board ID.
 	_NODE_check_node_and_board_id();
 	_NODE_check_function_pointer(get_sigfox_ul_payload);
-	// Reset payload.
-	for (idx=0 ; idx<NODE_SIGFOX_PAYLOAD_SIZE_MAX ; idx++) node_ctx.sigfox_ul_payload.frame[idx] = 0x00;
-	node_ctx.sigfox_ul_payload_size = 0;
-	// Add board ID and node address.
-	node_ctx.sigfox_ul_payload.board_id = (node -> board_id);
-	node_ctx.sigfox_ul_payload.node_address = (node -> address);
-	node_ctx.sigfox_ul_payload_size = 2;
-	// Add specific payload.
+	// Build specific payload.
 	switch (ul_payload_type) {
 	case NODE_SIGFOX_PAYLOAD_TYPE_STARTUP:
 		// Check node protocol.
@@ -344,111 +1056,362 @@ NODE_status_t _NODE_radio_send(NODE_t* node, NODE_sigfox_ul_payload_type_t ul_pa
 		sigfox_payload_startup.commit_index = node_ctx.data.registers_value[DINFOX_REGISTER_SW_VERSION_COMMIT_INDEX];
 		sigfox_payload_startup.commit_id = node_ctx.data.registers_value[DINFOX_REGISTER_SW_VERSION_COMMIT_ID];
 		sigfox_payload_startup.dirty_flag = node_ctx.data.registers_value[DINFOX_REGISTER_SW_VERSION_DIRTY_FLAG];
-		// Add specific data to global paylaod.
 		for (idx=0 ; idx<NODE_SIGFOX_PAYLOAD_STARTUP_SIZE ; idx++) {
-			node_ctx.sigfox_ul_payload.node_data[idx] = sigfox_payload_startup.frame[idx];
+			record_data[idx] = sigfox_payload_startup.frame[idx];
 		}
-		node_ctx.sigfox_ul_payload_size += NODE_SIGFOX_PAYLOAD_STARTUP_SIZE;
+		record_data_size = NODE_SIGFOX_PAYLOAD_STARTUP_SIZE;
 		break;
 	case NODE_SIGFOX_PAYLOAD_TYPE_MONITORING:
 	case NODE_SIGFOX_PAYLOAD_TYPE_DATA:
 		// Execute function of the corresponding board ID.
-		status = NODES[node -> board_id].functions.get_sigfox_ul_payload(node_ctx.data.registers_value, ul_payload_type, node_ctx.sigfox_ul_payload.node_data, &sigfox_payload_specific_size);
+		status = NODES[node -> board_id].functions.get_sigfox_ul_payload(node_ctx.data.registers_value, ul_payload_type, record_data, &record_data_size);
 		if (status != NODE_SUCCESS) goto errors;
-		// Update frame size.
-		node_ctx.sigfox_ul_payload_size += sigfox_payload_specific_size;
 		break;
 	default:
 		status = NODE_ERROR_SIGFOX_PAYLOAD_TYPE;
 		goto errors;
 	}
-	// Check UHFM board availability.
-	if (node_ctx.uhfm_address == DINFOX_NODE_ADDRESS_BROADCAST) {
-		status = NODE_ERROR_NONE_RADIO_MODULE;
+	// Check remaining space in the frame.
+	if ((node_ctx.sigfox_ul_payload_size + NODE_SIGFOX_UL_RECORD_HEADER_SIZE + record_data_size) > NODE_SIGFOX_PAYLOAD_SIZE_MAX) {
+		status = NODE_ERROR_SIGFOX_PAYLOAD_FULL;
 		goto errors;
 	}
-	// Build Sigfox message structure.
-	sigfox_message.ul_payload = (uint8_t*) node_ctx.sigfox_ul_payload.frame;
-	sigfox_message.ul_payload_size = node_ctx.sigfox_ul_payload_size;
-	sigfox_message.bidirectional_flag = bidirectional_flag;
-	// Send message.
-	status = UHFM_send_sigfox_message(node_ctx.uhfm_address, &sigfox_message, &send_status);
-	if (status != NODE_SUCCESS) goto errors;
-	// Check send status.
-	if (send_status.all != 0) {
-		status = NODE_ERROR_SIGFOX_SEND;
-		goto errors;
+	// Add record header.
+	record_header.node_address = (node -> address);
+	record_header.data_size = record_data_size;
+	record_header.board_id = (node -> board_id);
+	for (idx=0 ; idx<NODE_SIGFOX_UL_RECORD_HEADER_SIZE ; idx++) {
+		node_ctx.sigfox_ul_payload[node_ctx.sigfox_ul_payload_size++] = record_header.frame[idx];
 	}
-	// Set startup data flag of the corresponding node.
+	// Add record data.
+	for (idx=0 ; idx<record_data_size ; idx++) {
+		node_ctx.sigfox_ul_payload[node_ctx.sigfox_ul_payload_size++] = record_data[idx];
+	}
+	// Startup record is 10 bytes long, so there is at most one per frame.
 	if (ul_payload_type == NODE_SIGFOX_PAYLOAD_TYPE_STARTUP) {
-		(node -> startup_data_sent) = 1;
+		node_ctx.sigfox_ul_startup_node = node;
 	}
 errors:
 	return status;
 }
 
-/* READ NODE COMMAND FROM RADIO.
- * @param:			None.
- * @return status:	Function execution status.
+/* CHECK IF A RECORD IS ALREADY IN THE CURRENT SIGFOX UPLINK PAYLOAD.
+ * @param node_index:		Index of the node in list.
+ * @param ul_payload_type:	Payload type of the record.
+ * @return:					1 if the record has already been added, 0 otherwise.
  */
-NODE_status_t _NODE_radio_read(void) {
+static uint8_t _NODE_is_ul_record_added(uint8_t node_index, NODE_sigfox_ul_payload_type_t ul_payload_type) {
 	// Local variables.
-	NODE_status_t status = NODE_SUCCESS;
-	NODE_access_status_t read_status;
-	// Read downlink payload.
-	status = UHFM_get_dl_payload(node_ctx.uhfm_address, node_ctx.sigfox_dl_payload.frame, &read_status);
-	if (status != NODE_SUCCESS) {
-		node_ctx.sigfox_dl_payload.operation_code = NODE_DOWNLINK_OPERATION_CODE_NOP;
-		goto errors;
-	}
-	// Check send status.
-	if (read_status.all != 0) {
-		node_ctx.sigfox_dl_payload.operation_code = NODE_DOWNLINK_OPERATION_CODE_NOP;
-		status = NODE_ERROR_SIGFOX_READ;
+	uint8_t idx = 0;
+	// Records loop.
+	for (idx=0 ; idx<node_ctx.sigfox_ul_records_count ; idx++) {
+		if ((node_ctx.sigfox_ul_records[idx].node_index == node_index) && (node_ctx.sigfox_ul_records[idx].ul_payload_type == ul_payload_type)) return 1;
+	}
+	return 0;
+}
+
+/* SCHEDULE THE NEXT TRANSMISSION OF A RECORD.
+ * @param time_seconds:		Current time.
+ * @param node_index:		Index of the node in list.
+ * @param ul_payload_type:	Payload type of the record.
+ * @return:					None.
+ */
+static void _NODE_schedule_ul_record(uint32_t time_seconds, uint8_t node_index, NODE_sigfox_ul_payload_type_t ul_payload_type) {
+	node_ctx.sigfox_ul_record_time_seconds[node_index][ul_payload_type] = time_seconds + (NODES_SIGFOX_UL_SCHEDULE[NODES_LIST.list[node_index].board_id].period_multiplier[ul_payload_type] * node_ctx.sigfox_ul_period_seconds);
+}
+
+/* SELECT THE NEXT RECORD TO ADD IN SIGFOX UPLINK PAYLOAD.
+ * @param time_seconds:		Current time.
+ * @param node_index:		Pointer to byte that will contain the index of the selected node in list.
+ * @param ul_payload_type:	Pointer that will contain the selected payload type.
+ * @return record_found:	1 if a record is due, 0 otherwise.
+ */
+static uint8_t _NODE_select_ul_record(uint32_t time_seconds, uint8_t* node_index, NODE_sigfox_ul_payload_type_t* ul_payload_type) {
+	// Local variables.
+	uint8_t record_found = 0;
+	uint8_t board_id = 0;
+	uint8_t record_priority = 0;
+	uint32_t record_time_seconds = 0;
+	uint8_t idx = 0;
+	uint8_t type_idx = 0;
+	// Search the due record with the earliest deadline.
+	for (idx=0 ; idx<NODES_LIST.count ; idx++) {
+		board_id = NODES_LIST.list[idx].board_id;
+		if (board_id >= DINFOX_BOARD_ID_LAST) continue;
+		for (type_idx=0 ; type_idx<NODE_SIGFOX_PAYLOAD_TYPE_LAST ; type_idx++) {
+			// Skip unsupported payload types without any bus access.
+			if ((NODES_SIGFOX_UL_SCHEDULE[board_id].payload_types & (0b1 << type_idx)) == 0) continue;
+			// Startup data is sent only once.
+			if ((type_idx == NODE_SIGFOX_PAYLOAD_TYPE_STARTUP) && (NODES_LIST.list[idx].startup_data_sent != 0)) continue;
+			// Check deadline.
+			if (node_ctx.sigfox_ul_record_time_seconds[idx][type_idx] > time_seconds) continue;
+			if (_NODE_is_ul_record_added(idx, type_idx) != 0) continue;
+			// Compare with current selection.
+			if ((record_found == 0) ||
+				(node_ctx.sigfox_ul_record_time_seconds[idx][type_idx] < record_time_seconds) ||
+				((node_ctx.sigfox_ul_record_time_seconds[idx][type_idx] == record_time_seconds) && (NODES_SIGFOX_UL_SCHEDULE[board_id].priority < record_priority))) {
+				record_found = 1;
+				record_time_seconds = node_ctx.sigfox_ul_record_time_seconds[idx][type_idx];
+				record_priority = NODES_SIGFOX_UL_SCHEDULE[board_id].priority;
+				(*node_index) = idx;
+				(*ul_payload_type) = type_idx;
+			}
+		}
+	}
+	return record_found;
+}
+
+/* CHECK IF THE CURRENT REGISTERS VALUE OF A NODE CROSSED THE HYSTERESIS OF ITS LAST TRANSMITTED DATA.
+ * @param node_index:		Index of the node in list (registers must have been updated before).
+ * @return change_flag:		1 if at least one register crossed its hysteresis, 0 otherwise.
+ */
+static uint8_t _NODE_get_data_change(uint8_t node_index) {
+	// Local variables.
+	const NODE_hysteresis_t* hysteresis = NODES_SIGFOX_UL_SCHEDULE[NODES_LIST.list[node_index].board_id].data_hysteresis;
+	int64_t value = 0;
+	int64_t reference = 0;
+	uint64_t delta = 0;
+	uint64_t threshold = 0;
+	uint8_t idx = 0;
+	// Registers loop.
+	for (idx=0 ; idx<NODES_SIGFOX_UL_SCHEDULE[NODES_LIST.list[node_index].board_id].data_hysteresis_size ; idx++) {
+		// Skip registers which could not be read and registers without any reference.
+		if (node_ctx.data.registers_status[hysteresis[idx].register_address].all != 0) continue;
+		if ((node_ctx.sigfox_ul_data_reference_mask[node_index] & (0b1 << idx)) == 0) continue;
+		// Use 64-bits arithmetic since the difference of two 32-bits registers may not fit in 32 bits.
+		value = (int64_t) node_ctx.data.registers_value[hysteresis[idx].register_address];
+		reference = (int64_t) node_ctx.sigfox_ul_data_reference[node_index][idx];
+		delta = (uint64_t) ((value > reference) ? (value - reference) : (reference - value));
+		// Compute threshold.
+		threshold = hysteresis[idx].threshold;
+		if (hysteresis[idx].type == NODE_HYSTERESIS_TYPE_RELATIVE) {
+			threshold = (((uint64_t) ((reference < 0) ? (-reference) : reference)) * hysteresis[idx].threshold) / 100;
+		}
+		if (delta > threshold) return 1;
+	}
+	return 0;
+}
+
+/* SAVE THE MONITORED REGISTERS VALUE OF A DATA RECORD.
+ * @param record:	Pointer to the record (registers of its node must have been updated before).
+ * @return:			None.
+ */
+static void _NODE_save_data_reference(NODE_sigfox_ul_record_t* record) {
+	// Local variables.
+	const NODE_hysteresis_t* hysteresis = NODES_SIGFOX_UL_SCHEDULE[NODES_LIST.list[record -> node_index].board_id].data_hysteresis;
+	uint8_t idx = 0;
+	// Registers loop.
+	(record -> data_reference_mask) = 0;
+	for (idx=0 ; idx<NODES_SIGFOX_UL_SCHEDULE[NODES_LIST.list[record -> node_index].board_id].data_hysteresis_size ; idx++) {
+		// Error values are never used as reference.
+		if (node_ctx.data.registers_status[hysteresis[idx].register_address].all != 0) continue;
+		(record -> data_reference)[idx] = node_ctx.data.registers_value[hysteresis[idx].register_address];
+		(record -> data_reference_mask) |= (0b1 << idx);
+	}
+}
+
+/* STORE THE TRANSMITTED DATA OF A RECORD AS REFERENCE FOR THE NEXT CHANGE DETECTION.
+ * @param record:	Pointer to the record which has been sent.
+ * @return:			None.
+ */
+static void _NODE_store_data_reference(NODE_sigfox_ul_record_t* record) {
+	// Local variables.
+	uint8_t idx = 0;
+	// Registers loop.
+	for (idx=0 ; idx<NODES_SIGFOX_UL_SCHEDULE[NODES_LIST.list[record -> node_index].board_id].data_hysteresis_size ; idx++) {
+		// Keep previous reference of the registers which could not be read.
+		if (((record -> data_reference_mask) & (0b1 << idx)) == 0) continue;
+		node_ctx.sigfox_ul_data_reference[record -> node_index][idx] = (record -> data_reference)[idx];
+		node_ctx.sigfox_ul_data_reference_mask[record -> node_index] |= (0b1 << idx);
+	}
+}
+
+/* UPDATE SCHEDULE AND REFERENCES OF THE RECORDS WHICH HAVE BEEN SENT.
+ * @param time_seconds:	Time at which the records were selected.
+ * @return:				None.
+ */
+static void _NODE_commit_ul_records(uint32_t time_seconds) {
+	// Local variables.
+	NODE_sigfox_ul_record_t* record = NULL;
+	uint8_t idx = 0;
+	// Records loop.
+	for (idx=0 ; idx<node_ctx.sigfox_ul_records_count ; idx++) {
+		record = &(node_ctx.sigfox_ul_records[idx]);
+		_NODE_schedule_ul_record(time_seconds, (record -> node_index), (record -> ul_payload_type));
+		// Update reference of the data sent by exception.
+		if (((record -> ul_payload_type) == NODE_SIGFOX_PAYLOAD_TYPE_DATA) && (NODES_SIGFOX_UL_SCHEDULE[NODES_LIST.list[record -> node_index].board_id].data_hysteresis != NULL)) {
+			_NODE_store_data_reference(record);
+		}
+	}
+}
+
+/* SCHEDULE DATA PAYLOAD OF THE NODES WHOSE DATA CHANGED SINCE LAST TRANSMISSION.
+ * @param time_seconds:	Current time.
+ * @return status:		Function execution status.
+ */
+static NODE_status_t _NODE_check_data_changes(uint32_t time_seconds) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	uint8_t board_id = 0;
+	uint8_t idx = 0;
+	// Nodes loop.
+	for (idx=0 ; idx<NODES_LIST.count ; idx++) {
+		board_id = NODES_LIST.list[idx].board_id;
+		if (board_id >= DINFOX_BOARD_ID_LAST) continue;
+		// Check if data is sent by exception.
+		if (NODES_SIGFOX_UL_SCHEDULE[board_id].data_hysteresis == NULL) continue;
+		// Nothing to check if data is already due (reference is not valid before the first transmission).
+		if (node_ctx.sigfox_ul_record_time_seconds[idx][NODE_SIGFOX_PAYLOAD_TYPE_DATA] <= time_seconds) continue;
+		// Do not wait for a node which does not answer.
+		if (_NODE_is_backoff_running(&(NODES_LIST.list[idx])) != 0) continue;
+		// Read node.
+		status = NODE_update_registers(&(NODES_LIST.list[idx]));
+		if (status != NODE_SUCCESS) goto errors;
+		// Schedule data payload as soon as possible if needed.
+		if (_NODE_get_data_change(idx) != 0) {
+			node_ctx.sigfox_ul_record_time_seconds[idx][NODE_SIGFOX_PAYLOAD_TYPE_DATA] = 0;
+		}
 	}
 errors:
 	return status;
 }
 
-/* REMOVE ACTION IN LIST.
+/* SEND SIGFOX UPLINK PAYLOAD THROUGH RADIO.
+ * @param bidirectional_flag:	Downlink request flag.
+ * @return status:				Function execution status.
+ */
+NODE_status_t _NODE_radio_send(uint8_t bidirectional_flag) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	UHFM_sigfox_message_t sigfox_message;
+	NODE_access_status_t send_status;
+	// Check UHFM board availability.
+	if (node_ctx.uhfm_address == DINFOX_NODE_ADDRESS_BROADCAST) {
+		status = NODE_ERROR_NONE_RADIO_MODULE;
+		goto errors;
+	}
+	// Build Sigfox message structure.
+	sigfox_message.ul_payload = (uint8_t*) node_ctx.sigfox_ul_payload;
+	sigfox_message.ul_payload_size = node_ctx.sigfox_ul_payload_size;
+	sigfox_message.bidirectional_flag = bidirectional_flag;
+	// Check bidirectional flag.
+	if (bidirectional_flag != 0) {
+		// Start message and release the bus, downlink payload will be polled during the transaction.
+		status = UHFM_start_sigfox_message(node_ctx.uhfm_address, &sigfox_message, &send_status);
+	}
+	else {
+		// Send message.
+		status = UHFM_send_sigfox_message(node_ctx.uhfm_address, &sigfox_message, &send_status);
+	}
+	if (status != NODE_SUCCESS) goto errors;
+	// Check send status.
+	if (send_status.all != 0) {
+		status = NODE_ERROR_SIGFOX_SEND;
+		goto errors;
+	}
+	// Schedule downlink polling.
+	if (bidirectional_flag != 0) {
+		node_ctx.sigfox_dl_pending = 1;
+		node_ctx.sigfox_dl_poll_time_seconds = RTC_get_time_seconds() + UHFM_SIGFOX_DOWNLINK_DELAY_SECONDS;
+		node_ctx.sigfox_dl_collect_time_seconds = RTC_get_time_seconds() + UHFM_SIGFOX_DOWNLINK_DURATION_SECONDS;
+	}
+	// Set startup data flag of the corresponding node.
+	if (node_ctx.sigfox_ul_startup_node != NULL) {
+		(node_ctx.sigfox_ul_startup_node -> startup_data_sent) = 1;
+	}
+errors:
+	return status;
+}
+
+/* POLL NODE COMMAND FROM RADIO.
+ * @param dl_received:	Pointer to byte that will contain 1 if the downlink payload has been read, 0 otherwise.
+ * @return status:		Function execution status.
+ */
+NODE_status_t _NODE_radio_read(uint8_t* dl_received) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	NODE_access_status_t read_status;
+	// Reset output and schedule next poll.
+	(*dl_received) = 0;
+	node_ctx.sigfox_dl_poll_time_seconds = RTC_get_time_seconds() + NODE_SIGFOX_DL_POLL_PERIOD_SECONDS;
+	// Read downlink payload (short transaction, the UHFM answers an error until the downlink is available).
+	status = UHFM_get_dl_payload(node_ctx.uhfm_address, node_ctx.sigfox_dl_payload.frame, &read_status);
+	if ((status == NODE_SUCCESS) && (read_status.all == 0)) {
+		node_ctx.sigfox_dl_pending = 0;
+		(*dl_received) = 1;
+		goto errors;
+	}
+	node_ctx.sigfox_dl_payload.operation_code = NODE_DOWNLINK_OPERATION_CODE_NOP;
+	// Give up once the transaction is over.
+	if (RTC_get_time_seconds() >= node_ctx.sigfox_dl_collect_time_seconds) {
+		node_ctx.sigfox_dl_pending = 0;
+		if (status == NODE_SUCCESS) {
+			status = NODE_ERROR_SIGFOX_READ;
+		}
+	}
+errors:
+	return status;
+}
+
+/* REMOVE ACTION FROM QUEUE.
  * @param action_index:	Action to remove.
  * @return status:		Function execution status.
  */
-	NODE_status_t _NODE_remove_action(uint8_t action_index) {
+NODE_status_t _NODE_remove_action(uint8_t action_index) {
 	// Local variables.
 	NODE_status_t status = NODE_SUCCESS;
+	uint8_t idx = 0;
 	// Check parameter.
-	if (action_index >= NODE_ACTIONS_DEPTH) {
+	if (action_index >= node_ctx.actions_count) {
 		status = NODE_ERROR_ACTION_INDEX;
 		goto errors;
 	}
-	node_ctx.actions[action_index].node = NULL;
-	node_ctx.actions[action_index].register_address = 0x00;
-	node_ctx.actions[action_index].register_value = 0;
-	node_ctx.actions[action_index].timestamp_seconds = 0;
+	// Shift next actions to keep the queue sorted.
+	for (idx=action_index ; idx<(node_ctx.actions_count - 1) ; idx++) {
+		node_ctx.actions[idx] = node_ctx.actions[idx + 1];
+	}
+	node_ctx.actions_count--;
+	// Reset unused entry.
+	node_ctx.actions[node_ctx.actions_count].node = NULL;
+	node_ctx.actions[node_ctx.actions_count].register_address = 0x00;
+	node_ctx.actions[node_ctx.actions_count].register_value = 0;
+	node_ctx.actions[node_ctx.actions_count].timestamp_seconds = 0;
+	node_ctx.actions[node_ctx.actions_count].retry_count = 0;
 errors:
 	return status;
 }
 
-/* RECORD NEW ACTION IN LIST.
+/* RECORD NEW ACTION IN QUEUE.
  * @param action:	Pointer to the action to store.
  * @return status:	Function execution status.
  */
 NODE_status_t _NODE_record_action(NODE_action_t* action) {
 	// Local variables.
 	NODE_status_t status = NODE_SUCCESS;
+	uint8_t action_index = 0;
 	// Check parameter.
 	if (action == NULL) {
 		status = NODE_ERROR_NULL_PARAMETER;
 		goto errors;
 	}
+	// Pending actions are never overwritten.
+	if (node_ctx.actions_count >= NODE_ACTIONS_DEPTH) {
+		status = NODE_ERROR_ACTION_OVERFLOW;
+		goto errors;
+	}
+	// Insert after all actions with an earlier or equal timestamp (actions with the same timestamp are executed in recording order).
+	action_index = node_ctx.actions_count;
+	while ((action_index > 0) && (node_ctx.actions[action_index - 1].timestamp_seconds > (action -> timestamp_seconds))) {
+		node_ctx.actions[action_index] = node_ctx.actions[action_index - 1];
+		action_index--;
+	}
 	// Store action.
-	node_ctx.actions[node_ctx.actions_index].node = (action -> node);
-	node_ctx.actions[node_ctx.actions_index].register_address = (action -> register_address);
-	node_ctx.actions[node_ctx.actions_index].register_value = (action -> register_value);
-	node_ctx.actions[node_ctx.actions_index].timestamp_seconds = (action -> timestamp_seconds);
-	// Increment index.
-	node_ctx.actions_index = (node_ctx.actions_index + 1) % NODE_ACTIONS_DEPTH;
+	node_ctx.actions[action_index].node = (action -> node);
+	node_ctx.actions[action_index].register_address = (action -> register_address);
+	node_ctx.actions[action_index].register_value = (action -> register_value);
+	node_ctx.actions[action_index].timestamp_seconds = (action -> timestamp_seconds);
+	node_ctx.actions[action_index].retry_count = (action -> retry_count);
+	node_ctx.actions_count++;
 errors:
 	return status;
 }
@@ -484,6 +1447,7 @@ NODE_status_t _NODE_execute_downlink(void) {
 	// Create action structure.
 	action.node = &NODES_LIST.list[idx];
 	action.register_address = node_ctx.sigfox_dl_payload.register_address;
+	action.retry_count = 0;
 	// Check operation code.
 	switch (node_ctx.sigfox_dl_payload.operation_code) {
 	case NODE_DOWNLINK_OPERATION_CODE_NOP:
@@ -493,27 +1457,32 @@ NODE_status_t _NODE_execute_downlink(void) {
 		// Instantaneous write operation.
 		action.register_value = node_ctx.sigfox_dl_payload.data;
 		action.timestamp_seconds = 0;
-		_NODE_record_action(&action);
+		status = _NODE_record_action(&action);
+		if (status != NODE_SUCCESS) goto errors;
 		break;
 	case NODE_DOWNLINK_OPERATION_CODE_TOGGLE_OFF_ON:
 		// Instantaneous OFF command.
 		action.register_value = 0;
 		action.timestamp_seconds = 0;
-		_NODE_record_action(&action);
+		status = _NODE_record_action(&action);
+		if (status != NODE_SUCCESS) goto errors;
 		// Program ON command.
 		action.register_value = 1;
 		action.timestamp_seconds = RTC_get_time_seconds() + node_ctx.sigfox_dl_payload.data;
-		_NODE_record_action(&action);
+		status = _NODE_record_action(&action);
+		if (status != NODE_SUCCESS) goto errors;
 		break;
 	case NODE_DOWNLINK_OPERATION_CODE_TOGGLE_ON_OFF:
 		// Instantaneous ON command.
 		action.register_value = 1;
 		action.timestamp_seconds = 0;
-		_NODE_record_action(&action);
+		status = _NODE_record_action(&action);
+		if (status != NODE_SUCCESS) goto errors;
 		// Program OFF command.
 		action.register_value = 0;
 		action.timestamp_seconds = RTC_get_time_seconds() + node_ctx.sigfox_dl_payload.data;
-		_NODE_record_action(&action);
+		status = _NODE_record_action(&action);
+		if (status != NODE_SUCCESS) goto errors;
 		break;
 	default:
 		status = NODE_ERROR_DOWNLINK_OPERATION_CODE;
@@ -531,19 +1500,48 @@ NODE_status_t _NODE_execute_actions(void) {
 	// Local variables.
 	NODE_status_t status = NODE_SUCCESS;
 	NODE_access_status_t write_status;
+	NODE_action_t action;
+	NODE_t* node = NULL;
+	uint32_t time_seconds = RTC_get_time_seconds();
+	uint8_t write_failed = 0;
 	uint8_t idx = 0;
-	// Loop on action table.
-	for (idx=0 ; idx<NODE_ACTIONS_DEPTH ; idx++) {
-		// Check NODE pointer and timestamp.
-		if ((node_ctx.actions[idx].node != NULL) && (RTC_get_time_seconds() >= node_ctx.actions[idx].timestamp_seconds)) {
+	// Queue is sorted so that only the first actions can be due.
+	while ((node_ctx.actions_count > 0) && (time_seconds >= node_ctx.actions[0].timestamp_seconds)) {
+		// Execute all due actions of the same node in a row.
+		node = node_ctx.actions[0].node;
+		idx = 0;
+		while ((idx < node_ctx.actions_count) && (time_seconds >= node_ctx.actions[idx].timestamp_seconds)) {
+			// Check node.
+			if (node_ctx.actions[idx].node != node) {
+				idx++;
+				continue;
+			}
 			// Perform write operation.
 			status = _NODE_write_register(node_ctx.actions[idx].node, node_ctx.actions[idx].register_address, node_ctx.actions[idx].register_value, &write_status);
 			if (status != NODE_SUCCESS) goto errors;
-			// Remove action.
+			// Remove action (next action is shifted to the current index).
+			action = node_ctx.actions[idx];
 			status = _NODE_remove_action(idx);
 			if (status != NODE_SUCCESS) goto errors;
+			// Check write status.
+			if (write_status.all != 0) {
+				// Record the action again later until the maximum number of attempts is reached.
+				if (action.retry_count < NODE_ACTION_RETRY_MAX) {
+					action.retry_count++;
+					action.timestamp_seconds = (time_seconds + NODE_ACTION_RETRY_DELAY_SECONDS);
+					status = _NODE_record_action(&action);
+					if (status != NODE_SUCCESS) goto errors;
+				}
+				else {
+					write_failed = 1;
+				}
+			}
 		}
 	}
+	// Report dropped actions.
+	if (write_failed != 0) {
+		status = NODE_ERROR_ACTION_WRITE;
+	}
 errors:
 	return status;
 }
@@ -560,14 +1558,35 @@ void NODE_init(void) {
 	// Reset node list.
 	_NODE_flush_list();
 	// Init context.
-	node_ctx.sigfox_ul_node_list_index = 0;
 	node_ctx.sigfox_ul_period_seconds = NODE_SIGFOX_UL_PERIOD_SECONDS_DEFAULT;
 	node_ctx.sigfox_ul_next_time_seconds = 0;
-	node_ctx.sigfox_ul_payload_type_index = 0;
+	_NODE_flush_ul_payload();
 	node_ctx.sigfox_dl_period_seconds = NODE_SIGFOX_DL_PERIOD_SECONDS_DEFAULT;
 	node_ctx.sigfox_dl_next_time_seconds = 0;
-	for (idx=0 ; idx<NODE_ACTIONS_DEPTH ; idx++) _NODE_remove_action(idx);
-	node_ctx.actions_index = 0;
+	node_ctx.sigfox_dl_pending = 0;
+	node_ctx.sigfox_dl_poll_time_seconds = 0;
+	node_ctx.sigfox_dl_collect_time_seconds = 0;
+	node_ctx.actions_count = 0;
+	for (idx=0 ; idx<NODE_ACTIONS_DEPTH ; idx++) {
+		node_ctx.actions[idx].node = NULL;
+		node_ctx.actions[idx].register_address = 0x00;
+		node_ctx.actions[idx].register_value = 0;
+		node_ctx.actions[idx].timestamp_seconds = 0;
+		node_ctx.actions[idx].retry_count = 0;
+	}
+	node_ctx.uhfm_address = DINFOX_NODE_ADDRESS_BROADCAST;
+	node_ctx.scan_next_address = DINFOX_NODE_ADDRESS_BROADCAST;
+	node_ctx.scan_list_updated = 0;
+	node_ctx.scan_next_time_seconds = 0;
+	node_ctx.scan_budget_ms = NODE_SCAN_BUDGET_MS_DEFAULT;
+	node_ctx.statistics_node_address = DINFOX_NODE_ADDRESS_BROADCAST;
+	node_ctx.statistics_register_address = 0;
+	node_ctx.statistics_window = NODE_STATISTICS_WINDOW_DEFAULT;
+	MATH_statistics_reset(&node_ctx.statistics);
+	node_ctx.data_pending_mask = 0;
+	node_ctx.registers_read_mask = 0;
+	node_ctx.data_no_reply_flag = 0;
+	node_ctx.cache_ttl_seconds = NODE_CACHE_TTL_SECONDS_DEFAULT;
 	// Init interface layers.
 	AT_BUS_init();
 }
@@ -604,12 +1623,12 @@ errors:
 	return status;
 }
 
-/* PERFORM A SINGLE NODE MEASUREMENT.
+/* FORMAT A SINGLE NODE STRING DATA FROM REGISTERS VALUE.
  * @param node:					Node to update.
  * @param string_data_index:	Node string data index.
  * @return status:				Function execution status.
  */
-NODE_status_t NODE_update_data(NODE_t* node, uint8_t string_data_index) {
+NODE_status_t _NODE_update_string_data(NODE_t* node, uint8_t string_data_index) {
 	// Local variables.
 	NODE_status_t status = NODE_SUCCESS;
 	NODE_data_update_t data_update;
@@ -624,6 +1643,7 @@ NODE_status_t NODE_update_data(NODE_t* node, uint8_t string_data_index) {
 	data_update.name_ptr = (char_t*) &(node_ctx.data.string_data_name[string_data_index]);
 	data_update.value_ptr = (char_t*) &(node_ctx.data.string_data_value[string_data_index]);
 	data_update.registers_value_ptr = (int32_t*) node_ctx.data.registers_value;
+	data_update.registers_status_ptr = (NODE_access_status_t*) node_ctx.data.registers_status;
 	// Check node protocol.
 	switch (NODES[node -> board_id].protocol) {
 	case NODE_PROTOCOL_AT_BUS:
@@ -646,11 +1666,68 @@ errors:
 	return status;
 }
 
-/* PERFORM ALL NODE MEASUREMENTS.
+/* GET THE REGISTERS USED BY A STRING DATA.
+ * @param node:					Node to update.
+ * @param string_data_index:	Node string data index.
+ * @param registers_range:		Pointer to the registers range to fill.
+ * @return:						None.
+ */
+static void _NODE_get_string_data_registers(NODE_t* node, uint8_t string_data_index, NODE_registers_range_t* registers_range) {
+	// Check node protocol.
+	if (NODES[node -> board_id].protocol == NODE_PROTOCOL_AT_BUS) {
+		if (string_data_index < DINFOX_STRING_DATA_INDEX_LAST) {
+			(*registers_range) = DINFOX_STRING_DATA_REGISTERS[string_data_index];
+		}
+		else {
+			(registers_range -> first_register_address) = (string_data_index + DINFOX_REGISTER_LAST - DINFOX_STRING_DATA_INDEX_LAST);
+			(registers_range -> number_of_registers) = 1;
+		}
+	}
+	else {
+		(registers_range -> first_register_address) = string_data_index;
+		(registers_range -> number_of_registers) = 1;
+	}
+}
+
+/* PERFORM A SINGLE NODE MEASUREMENT.
+ * @param node:					Node to update.
+ * @param string_data_index:	Node string data index.
+ * @return status:				Function execution status.
+ */
+NODE_status_t NODE_update_data(NODE_t* node, uint8_t string_data_index) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	NODE_registers_range_t registers_range;
+	uint8_t register_address = 0;
+	// Check board ID.
+	_NODE_check_node_and_board_id();
+	_NODE_check_function_pointer(update_data);
+	// Check index.
+	if (string_data_index >= (NODES[node -> board_id].last_string_data_index)) {
+		status = NODE_ERROR_STRING_DATA_INDEX;
+		goto errors;
+	}
+	// Always read the registers of this string data since a single data update is an explicit refresh request.
+	_NODE_get_string_data_registers(node, string_data_index, &registers_range);
+	status = _NODE_read_registers(node, registers_range.first_register_address, registers_range.number_of_registers);
+	if (status != NODE_SUCCESS) goto errors;
+	_NODE_cache_store(node, registers_range.first_register_address, registers_range.number_of_registers);
+	// These registers do not require any bus access anymore during a progressive update.
+	for (register_address=registers_range.first_register_address ; register_address<(registers_range.first_register_address + registers_range.number_of_registers) ; register_address++) {
+		node_ctx.registers_read_mask |= ((uint64_t) 0b1 << register_address);
+	}
+	node_ctx.data_pending_mask &= ~((uint32_t) 0b1 << string_data_index);
+	// Update string data.
+	status = _NODE_update_string_data(node, string_data_index);
+errors:
+	return status;
+}
+
+/* START A PROGRESSIVE UPDATE OF ALL NODE MEASUREMENTS.
  * @param node:		Node to update.
  * @return status:	Function execution status.
  */
-NODE_status_t NODE_update_all_data(NODE_t* node) {
+NODE_status_t NODE_start_update_all_data(NODE_t* node) {
 	// Local variables.
 	NODE_status_t status = NODE_SUCCESS;
 	uint8_t idx = 0;
@@ -663,10 +1740,170 @@ NODE_status_t NODE_update_all_data(NODE_t* node) {
 	}
 	// Reset buffers.
 	_NODE_flush_all_data_value();
-	// String data loop.
+	node_ctx.data_no_reply_flag = 0;
+	// Format all string data at once if registers have been read recently.
+	if (_NODE_cache_load(node, 0, NODES[node -> board_id].last_register_address) != 0) {
+		node_ctx.data_pending_mask = 0;
+		node_ctx.registers_read_mask = 0xFFFFFFFFFFFFFFFF;
+		// String data loop.
+		for (idx=0 ; idx<(NODES[node -> board_id].last_string_data_index) ; idx++) {
+			status = _NODE_update_string_data(node, idx);
+			if (status != NODE_SUCCESS) goto errors;
+		}
+		goto errors;
+	}
+	// Otherwise all string data will be updated one by one with NODE_update_pending_data().
+	node_ctx.data_pending_mask = 0;
 	for (idx=0 ; idx<(NODES[node -> board_id].last_string_data_index) ; idx++) {
-		status = NODE_update_data(node, idx);
+		node_ctx.data_pending_mask |= ((uint32_t) 0b1 << idx);
+	}
+	node_ctx.registers_read_mask = 0;
+errors:
+	return status;
+}
+
+/* READ A RANGE OF REGISTERS DURING A PROGRESSIVE UPDATE (IF NOT ALREADY DONE).
+ * @param node:						Node to read.
+ * @param first_register_address:	Address of the first register to read.
+ * @param number_of_registers:		Number of registers to read.
+ * @return status:					Function execution status.
+ */
+static NODE_status_t _NODE_read_pending_registers(NODE_t* node, uint8_t first_register_address, uint8_t number_of_registers) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	uint8_t reply_flag = 0;
+	uint8_t idx = 0;
+	// Check if registers have already been read.
+	if ((node_ctx.registers_read_mask & ((uint64_t) 0b1 << first_register_address)) != 0) goto errors;
+	// Do not spend bus timeouts again on a node which did not answer during this update.
+	if (node_ctx.data_no_reply_flag != 0) {
+		for (idx=first_register_address ; idx<(first_register_address + number_of_registers) ; idx++) {
+			node_ctx.data.registers_status[idx].reply_timeout = 1;
+		}
+	}
+	else {
+		status = _NODE_read_registers(node, first_register_address, number_of_registers);
 		if (status != NODE_SUCCESS) goto errors;
+		// Check if at least one register has been answered.
+		for (idx=first_register_address ; idx<(first_register_address + number_of_registers) ; idx++) {
+			if ((node_ctx.data.registers_status[idx].reply_timeout == 0) && (node_ctx.data.registers_status[idx].sequence_timeout == 0)) {
+				reply_flag = 1;
+			}
+		}
+		node_ctx.data_no_reply_flag = (reply_flag == 0) ? 1 : 0;
+	}
+	// Update mask.
+	for (idx=first_register_address ; idx<(first_register_address + number_of_registers) ; idx++) {
+		node_ctx.registers_read_mask |= ((uint64_t) 0b1 << idx);
+	}
+errors:
+	return status;
+}
+
+/* UPDATE ONE MEASUREMENT OF A PROGRESSIVE UPDATE (ONLY REGISTERS REQUIRED BY THIS STRING DATA ARE READ).
+ * @param node:					Node to update.
+ * @param string_data_index:	Node string data index.
+ * @return status:				Function execution status.
+ */
+NODE_status_t NODE_update_pending_data(NODE_t* node, uint8_t string_data_index) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	NODE_registers_range_t registers_range;
+	uint8_t register_address = 0;
+	// Check board ID.
+	_NODE_check_node_and_board_id();
+	// Check index.
+	if (string_data_index >= (NODES[node -> board_id].last_string_data_index)) {
+		status = NODE_ERROR_STRING_DATA_INDEX;
+		goto errors;
+	}
+	// Check if string data is still pending.
+	if ((node_ctx.data_pending_mask & ((uint32_t) 0b1 << string_data_index)) == 0) goto errors;
+	// Read registers used by the string data and format it.
+	_NODE_get_string_data_registers(node, string_data_index, &registers_range);
+	status = _NODE_read_pending_registers(node, registers_range.first_register_address, registers_range.number_of_registers);
+	if (status != NODE_SUCCESS) goto errors;
+	status = _NODE_update_string_data(node, string_data_index);
+	if (status != NODE_SUCCESS) goto errors;
+	node_ctx.data_pending_mask &= ~((uint32_t) 0b1 << string_data_index);
+	// Read remaining registers and update cache once all string data are available.
+	if (node_ctx.data_pending_mask == 0) {
+		for (register_address=0 ; register_address<(NODES[node -> board_id].last_register_address) ; register_address++) {
+			status = _NODE_read_pending_registers(node, register_address, 1);
+			if (status != NODE_SUCCESS) goto errors;
+		}
+		_NODE_cache_store(node, 0, NODES[node -> board_id].last_register_address);
+	}
+errors:
+	return status;
+}
+
+/* CHECK IF A MEASUREMENT OF THE CURRENT PROGRESSIVE UPDATE IS STILL PENDING.
+ * @param string_data_index:	Node string data index.
+ * @return:						1 if the string data has not been updated yet, 0 otherwise.
+ */
+uint8_t NODE_get_data_pending_flag(uint8_t string_data_index) {
+	// Check index.
+	if (string_data_index >= NODE_STRING_DATA_INDEX_MAX) return 0;
+	return (((node_ctx.data_pending_mask & ((uint32_t) 0b1 << string_data_index)) != 0) ? 1 : 0);
+}
+
+/* UPDATE A RANGE OF NODE REGISTERS FROM CACHE OR BUS.
+ * @param node:						Node to update.
+ * @param first_register_address:	Address of the first register to update.
+ * @param number_of_registers:		Number of registers to update.
+ * @return status:					Function execution status.
+ */
+static NODE_status_t _NODE_update_registers_range(NODE_t* node, uint8_t first_register_address, uint8_t number_of_registers) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	uint8_t register_address = 0;
+	// Use cache if it is fresh enough.
+	if (_NODE_cache_load(node, first_register_address, number_of_registers) != 0) goto errors;
+	// Do not spend bus timeouts on a node which did not answer recently: report registers as not answered.
+	if (_NODE_is_backoff_running(node) != 0) {
+		for (register_address=first_register_address ; register_address<(first_register_address + number_of_registers) ; register_address++) {
+			node_ctx.data.registers_status[register_address].reply_timeout = 1;
+		}
+		goto errors;
+	}
+	// Read registers and update cache.
+	status = _NODE_read_registers(node, first_register_address, number_of_registers);
+	if (status != NODE_SUCCESS) goto errors;
+	_NODE_cache_store(node, first_register_address, number_of_registers);
+errors:
+	return status;
+}
+
+/* READ NODE REGISTERS REQUIRED BY RADIO PAYLOADS WITHOUT FORMATTING STRING DATA.
+ * @param node:		Node to update.
+ * @return status:	Function execution status.
+ */
+NODE_status_t NODE_update_registers(NODE_t* node) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	// Check board ID.
+	_NODE_check_node_and_board_id();
+	// Check registers.
+	if ((NODES[node -> board_id].last_register_address) == 0) {
+		status = NODE_ERROR_NOT_SUPPORTED;
+		goto errors;
+	}
+	// Reset registers only.
+	_NODE_flush_registers_value();
+	// Check protocol.
+	if (NODES[node -> board_id].protocol == NODE_PROTOCOL_AT_BUS) {
+		// Startup payload registers.
+		if ((node -> startup_data_sent) == 0) {
+			status = _NODE_update_registers_range(node, DINFOX_REGISTER_SW_VERSION_MAJOR, (DINFOX_REGISTER_RESET_REASON - DINFOX_REGISTER_SW_VERSION_MAJOR + 1));
+			if (status != NODE_SUCCESS) goto errors;
+		}
+		// Monitoring and data payloads registers (MCU measurements followed by board specific registers).
+		status = _NODE_update_registers_range(node, DINFOX_REGISTER_TMCU_DEGREES, ((NODES[node -> board_id].last_register_address) - DINFOX_REGISTER_TMCU_DEGREES));
+	}
+	else {
+		// Read all registers.
+		status = _NODE_update_registers_range(node, 0, NODES[node -> board_id].last_register_address);
 	}
 errors:
 	return status;
@@ -728,10 +1965,13 @@ NODE_status_t NODE_scan(void) {
 	// Local variables.
 	NODE_status_t status = NODE_SUCCESS;
 	uint8_t nodes_count = 0;
-	uint8_t idx = 0;
 	// Reset list.
 	_NODE_flush_list();
 	node_ctx.uhfm_address = DINFOX_NODE_ADDRESS_BROADCAST;
+	// Full scan makes the next background sweep useless.
+	node_ctx.scan_next_address = DINFOX_NODE_ADDRESS_BROADCAST;
+	node_ctx.scan_list_updated = 0;
+	node_ctx.scan_next_time_seconds = RTC_get_time_seconds() + NODE_SCAN_PERIOD_SECONDS;
 	// Add master board to the list.
 	NODES_LIST.list[0].board_id = DINFOX_BOARD_ID_DMM;
 	NODES_LIST.list[0].address = DINFOX_NODE_ADDRESS_DMM;
@@ -741,20 +1981,85 @@ NODE_status_t NODE_scan(void) {
 	if (status != NODE_SUCCESS) goto errors;
 	// Update count.
 	NODES_LIST.count += nodes_count;
-	// Search UHFM board in nodes list.
-	for (idx=0 ; idx<NODES_LIST.count ; idx++) {
-		// Check board ID.
-		if (NODES_LIST.list[idx].board_id == DINFOX_BOARD_ID_UHFM) {
-			node_ctx.uhfm_address = NODES_LIST.list[idx].address;
-			break;
-		}
-	}
 	// Scan R4S8CR nodes.
 	status = R4S8CR_scan(&(NODES_LIST.list[NODES_LIST.count]), (NODES_LIST_SIZE_MAX - NODES_LIST.count), &nodes_count);
 	if (status != NODE_SUCCESS) goto errors;
 	// Update count.
 	NODES_LIST.count += nodes_count;
+	// Save list for next boot.
+	status = _NODE_save_list();
 errors:
+	// Search UHFM board in nodes list.
+	_NODE_update_uhfm_address();
+	return status;
+}
+
+/* RESTORE NODES LIST FROM NVM AND VERIFY IT.
+ * @param:			None.
+ * @return status:	Function executions status.
+ */
+NODE_status_t NODE_warm_scan(void) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	NVM_status_t nvm_status = NVM_SUCCESS;
+	NODE_address_t node_address = 0;
+	uint8_t board_id = 0;
+	uint8_t nvm_nodes_count = 0;
+	uint8_t node_found = 0;
+	uint8_t idx = 0;
+	// Read stored nodes count.
+	nvm_status = NVM_read_byte(NVM_ADDRESS_NODES_LIST_COUNT, &nvm_nodes_count);
+	NVM_status_check(NODE_ERROR_BASE_NVM);
+	// Perform full scan if no valid list is stored.
+	if ((nvm_nodes_count == 0) || (nvm_nodes_count > NODE_NVM_LIST_SIZE_MAX)) {
+		status = NODE_scan();
+		goto errors;
+	}
+	// Reset list.
+	_NODE_flush_list();
+	node_ctx.uhfm_address = DINFOX_NODE_ADDRESS_BROADCAST;
+	node_ctx.scan_list_updated = 0;
+	// Add master board to the list.
+	NODES_LIST.list[0].board_id = DINFOX_BOARD_ID_DMM;
+	NODES_LIST.list[0].address = DINFOX_NODE_ADDRESS_DMM;
+	NODES_LIST.count++;
+	// Verify known nodes first.
+	for (idx=0 ; idx<nvm_nodes_count ; idx++) {
+		// Check index.
+		if (NODES_LIST.count >= NODES_LIST_SIZE_MAX) break;
+		// Read stored node.
+		nvm_status = NVM_read_byte((NVM_ADDRESS_NODES_LIST + (idx << 1)), &node_address);
+		NVM_status_check(NODE_ERROR_BASE_NVM);
+		nvm_status = NVM_read_byte((NVM_ADDRESS_NODES_LIST + (idx << 1) + 1), &board_id);
+		NVM_status_check(NODE_ERROR_BASE_NVM);
+		// Probe node.
+		status = _NODE_probe(node_address, &(NODES_LIST.list[NODES_LIST.count]), &node_found);
+		if (status != NODE_SUCCESS) goto errors;
+		// Keep node only if it is still present.
+		if ((node_found != 0) && (_NODE_is_known_address(node_address) == 0)) {
+			// Board ID changed since last scan.
+			if (NODES_LIST.list[NODES_LIST.count].board_id != board_id) {
+				node_ctx.scan_list_updated = 1;
+			}
+			NODES_LIST.count++;
+		}
+		else {
+			// Node disappeared.
+			node_ctx.scan_list_updated = 1;
+		}
+		IWDG_reload();
+	}
+	// Restore unused entry.
+	if (NODES_LIST.count < NODES_LIST_SIZE_MAX) {
+		NODES_LIST.list[NODES_LIST.count].address = 0xFF;
+		NODES_LIST.list[NODES_LIST.count].board_id = DINFOX_BOARD_ID_ERROR;
+	}
+	// Other addresses will be scanned in background.
+	node_ctx.scan_next_address = 0;
+	node_ctx.scan_next_time_seconds = RTC_get_time_seconds();
+errors:
+	// Search UHFM board in nodes list.
+	_NODE_update_uhfm_address();
 	return status;
 }
 
@@ -808,6 +2113,182 @@ errors:
 	return status;
 }
 
+/* READ CURRENT REGISTERS CACHE TTL.
+ * @param:						None.
+ * @return cache_ttl_seconds:	Duration during which cached registers are used instead of reading the node.
+ */
+uint32_t NODE_get_cache_ttl(void) {
+	return node_ctx.cache_ttl_seconds;
+}
+
+/* SET REGISTERS CACHE TTL.
+ * @param cache_ttl_seconds:	New cache TTL in seconds (0 disables the cache).
+ * @return:						None.
+ */
+void NODE_set_cache_ttl(uint32_t cache_ttl_seconds) {
+	node_ctx.cache_ttl_seconds = cache_ttl_seconds;
+}
+
+/* GET BACKGROUND DISCOVERY TIME BUDGET.
+ * @param:	None.
+ * @return:	Maximum duration of the background probes performed at each node task wake-up in ms.
+ */
+uint32_t NODE_get_scan_budget(void) {
+	return node_ctx.scan_budget_ms;
+}
+
+/* SET BACKGROUND DISCOVERY TIME BUDGET.
+ * @param scan_budget_ms:	Maximum duration of the background probes performed at each node task wake-up in ms (a budget lower than one probe disables discovery).
+ * @return status:			Function execution status.
+ */
+NODE_status_t NODE_set_scan_budget(uint32_t scan_budget_ms) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	// Check parameter.
+	if (scan_budget_ms > NODE_SCAN_BUDGET_MS_MAX) {
+		status = NODE_ERROR_SCAN_BUDGET;
+		goto errors;
+	}
+	node_ctx.scan_budget_ms = scan_budget_ms;
+errors:
+	return status;
+}
+
+/* GET ADDRESS OF THE NODE SELECTED FOR STATISTICS.
+ * @param:	None.
+ * @return:	Address of the node whose register is monitored (broadcast address if disabled).
+ */
+NODE_address_t NODE_get_statistics_node_address(void) {
+	return node_ctx.statistics_node_address;
+}
+
+/* GET ADDRESS OF THE REGISTER SELECTED FOR STATISTICS.
+ * @param:	None.
+ * @return:	Address of the monitored register.
+ */
+uint8_t NODE_get_statistics_register_address(void) {
+	return node_ctx.statistics_register_address;
+}
+
+/* GET STATISTICS WINDOW LENGTH.
+ * @param:	None.
+ * @return:	Number of reads per window.
+ */
+uint16_t NODE_get_statistics_window(void) {
+	return node_ctx.statistics_window;
+}
+
+/* SELECT THE NODE MONITORED BY STATISTICS.
+ * @param node_address:	Address of the node to monitor (broadcast address to disable statistics).
+ * @return:				None.
+ */
+void NODE_set_statistics_node_address(NODE_address_t node_address) {
+	node_ctx.statistics_node_address = node_address;
+	MATH_statistics_reset(&node_ctx.statistics);
+}
+
+/* SELECT THE REGISTER MONITORED BY STATISTICS.
+ * @param register_address:	Address of the register to monitor.
+ * @return status:			Function execution status.
+ */
+NODE_status_t NODE_set_statistics_register_address(uint8_t register_address) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	// Check parameter.
+	if (register_address >= NODE_REGISTER_ADDRESS_MAX) {
+		status = NODE_ERROR_REGISTER_ADDRESS;
+		goto errors;
+	}
+	node_ctx.statistics_register_address = register_address;
+	MATH_statistics_reset(&node_ctx.statistics);
+errors:
+	return status;
+}
+
+/* SET STATISTICS WINDOW LENGTH.
+ * @param statistics_window:	Number of reads per window.
+ * @return status:				Function execution status.
+ */
+NODE_status_t NODE_set_statistics_window(uint16_t statistics_window) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	// Check parameter.
+	if ((statistics_window == 0) || (statistics_window == 0xFFFF)) {
+		status = NODE_ERROR_STATISTICS_WINDOW;
+		goto errors;
+	}
+	node_ctx.statistics_window = statistics_window;
+	MATH_statistics_reset(&node_ctx.statistics);
+errors:
+	return status;
+}
+
+/* GET RUNNING STATISTICS OF THE SELECTED REGISTER.
+ * @param statistics:	Pointer to the statistics of the current window.
+ * @return status:		Function execution status.
+ */
+NODE_status_t NODE_get_statistics(MATH_statistics_result_t* statistics) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	MATH_status_t math_status = MATH_SUCCESS;
+	// Compute result.
+	math_status = MATH_statistics_get(&node_ctx.statistics, statistics);
+	MATH_status_check(NODE_ERROR_BASE_MATH);
+errors:
+	return status;
+}
+
+/* GET NODE DEGRADED FLAG.
+ * @param node:		Node to check.
+ * @return:			1 if the node did not answer several consecutive reads, 0 otherwise.
+ */
+uint8_t NODE_get_degraded_flag(NODE_t* node) {
+	// Local variables.
+	uint8_t list_idx = 0;
+	// Check parameter.
+	if (node == NULL) return 0;
+	list_idx = _NODE_get_list_index(node);
+	if (list_idx >= NODES_LIST_SIZE_MAX) return 0;
+	return ((node_ctx.health[list_idx].failures_count >= NODE_DEGRADED_FAILURES_THRESHOLD) ? 1 : 0);
+}
+
+/* GET NUMBER OF DEGRADED NODES.
+ * @param:	None.
+ * @return:	Number of nodes which did not answer several consecutive reads.
+ */
+uint8_t NODE_get_degraded_count(void) {
+	// Local variables.
+	uint8_t degraded_count = 0;
+	uint8_t idx = 0;
+	// Nodes loop.
+	for (idx=0 ; idx<NODES_LIST.count ; idx++) {
+		if (node_ctx.health[idx].failures_count >= NODE_DEGRADED_FAILURES_THRESHOLD) degraded_count++;
+	}
+	return degraded_count;
+}
+
+/* GET THE NEXT TIME AT WHICH THE NODE TASK HAS SOMETHING TO DO.
+ * @param:						None.
+ * @return next_time_seconds:	Earliest RTC time of the next uplink, pending action or background scan step.
+ */
+uint32_t NODE_get_next_time_seconds(void) {
+	// Local variables.
+	uint32_t next_time_seconds = node_ctx.sigfox_ul_next_time_seconds;
+	// Downlink is always requested along with an uplink, and no uplink is sent until the pending downlink has been polled.
+	if (node_ctx.sigfox_dl_pending != 0) {
+		next_time_seconds = node_ctx.sigfox_dl_poll_time_seconds;
+	}
+	// Pending actions (queue is sorted).
+	if ((node_ctx.actions_count > 0) && (node_ctx.actions[0].timestamp_seconds < next_time_seconds)) {
+		next_time_seconds = node_ctx.actions[0].timestamp_seconds;
+	}
+	// Background sweep (next slice is scheduled at the following RTC wake-up while a sweep is running).
+	if ((node_ctx.scan_budget_ms >= NODE_SCAN_PROBE_DURATION_MS_MAX) && (node_ctx.scan_next_time_seconds < next_time_seconds)) {
+		next_time_seconds = node_ctx.scan_next_time_seconds;
+	}
+	return next_time_seconds;
+}
+
 /* MAIN TASK OF NODE LAYER.
  * @param:			None.
  * @return status:	Function execution status.
@@ -816,16 +2297,33 @@ NODE_status_t NODE_task(void) {
 	// Local variables.
 	NODE_status_t status = NODE_SUCCESS;
 	LPUART_status_t lpuart1_status = LPUART_SUCCESS;
-	uint32_t loop_count = 0;
+	NODE_sigfox_ul_payload_type_t ul_payload_type = 0;
+	NODE_sigfox_ul_record_t* record = NULL;
+	uint32_t time_seconds = 0;
+	uint8_t record_count = 0;
+	uint8_t node_index = 0;
+	uint8_t updated_node_index = NODES_LIST_SIZE_MAX;
+	uint8_t board_id = 0;
 	uint8_t bidirectional_flag = 0;
-	uint8_t node_update_required = 1;
 	uint8_t ul_next_time_update_required = 0;
 	uint8_t dl_next_time_update_required = 0;
+	uint8_t dl_received = 0;
 	// Turn bus interface on.
 	lpuart1_status = LPUART1_power_on();
 	LPUART1_status_check(NODE_ERROR_BASE_LPUART);
-	// Check uplink period.
-	if (RTC_get_time_seconds() >= node_ctx.sigfox_ul_next_time_seconds) {
+	// Poll downlink of the last bidirectional message.
+	if ((node_ctx.sigfox_dl_pending != 0) && (RTC_get_time_seconds() >= node_ctx.sigfox_dl_poll_time_seconds)) {
+		// Read downlink payload.
+		status = _NODE_radio_read(&dl_received);
+		if (status != NODE_SUCCESS) goto errors;
+		// Decode downlink payload.
+		if (dl_received != 0) {
+			status = _NODE_execute_downlink();
+			if (status != NODE_SUCCESS) goto errors;
+		}
+	}
+	// Check uplink period (radio module is busy while a downlink is pending).
+	if ((node_ctx.sigfox_dl_pending == 0) && (RTC_get_time_seconds() >= node_ctx.sigfox_ul_next_time_seconds)) {
 		// Next time update needed.
 		ul_next_time_update_required = 1;
 		// Check downlink period.
@@ -834,66 +2332,77 @@ NODE_status_t NODE_task(void) {
 			dl_next_time_update_required = 1;
 			bidirectional_flag = 1;
 		}
-		// Search next Sigfox message to send.
-		do {
+		// Check UHFM board availability.
+		if (node_ctx.uhfm_address == DINFOX_NODE_ADDRESS_BROADCAST) {
+			status = NODE_ERROR_NONE_RADIO_MODULE;
+			goto errors;
+		}
+		// Aggregate as many due records as possible in the uplink payload, by deadline order.
+		_NODE_flush_ul_payload();
+		time_seconds = RTC_get_time_seconds();
+		status = _NODE_check_data_changes(time_seconds);
+		if (status != NODE_SUCCESS) goto errors;
+		for (record_count=0 ; record_count<(NODES_LIST.count * NODE_SIGFOX_PAYLOAD_TYPE_LAST) ; record_count++) {
+			// Send the records already added if a higher priority task is ready (remaining ones are kept for next uplink).
+			if ((node_ctx.sigfox_ul_payload_size != 0) && (SCHEDULER_is_preemption_requested() != 0)) break;
+			if (node_ctx.sigfox_ul_records_count >= NODE_SIGFOX_UL_RECORDS_MAX) break;
+			// Select next record.
+			if (_NODE_select_ul_record(time_seconds, &node_index, &ul_payload_type) == 0) break;
+			board_id = NODES_LIST.list[node_index].board_id;
 			// Update node data if needed.
-			if (node_update_required != 0) {
-				status = NODE_update_all_data(&(NODES_LIST.list[node_ctx.sigfox_ul_node_list_index]));
-				node_update_required = 0;
-			}
-			else {
-				status = NODE_SUCCESS;
+			if (node_index != updated_node_index) {
+				status = NODE_update_registers(&(NODES_LIST.list[node_index]));
+				if (status != NODE_SUCCESS) goto errors;
+				updated_node_index = node_index;
 			}
-			if (status == NODE_SUCCESS) {
-				// Set radio times to now to compensate node update duration.
-				if (ul_next_time_update_required != 0) {
-					node_ctx.sigfox_ul_next_time_seconds = RTC_get_time_seconds();
-				}
-				if (dl_next_time_update_required != 0) {
-					node_ctx.sigfox_dl_next_time_seconds = RTC_get_time_seconds();
-				}
-				// Send data through radio.
-				status = _NODE_radio_send(&(NODES_LIST.list[node_ctx.sigfox_ul_node_list_index]), node_ctx.sigfox_ul_payload_type_index, bidirectional_flag);
-				// Handle all errors except not supported and empty payload.
-				if ((status != NODE_SUCCESS) && (status != NODE_ERROR_NOT_SUPPORTED) && (status != NODE_ERROR_SIGFOX_PAYLOAD_EMPTY)) goto errors;
+			// Add node data to the payload.
+			status = _NODE_add_ul_record(&(NODES_LIST.list[node_index]), ul_payload_type);
+			// Keep record for next uplink if the frame is full.
+			if (status == NODE_ERROR_SIGFOX_PAYLOAD_FULL) break;
+			// Handle all errors except not supported and empty payload.
+			if ((status != NODE_SUCCESS) && (status != NODE_ERROR_NOT_SUPPORTED) && (status != NODE_ERROR_SIGFOX_PAYLOAD_EMPTY)) goto errors;
+			// Schedule next transmission directly if there was nothing to add.
+			if (status != NODE_SUCCESS) {
+				_NODE_schedule_ul_record(time_seconds, node_index, ul_payload_type);
+				continue;
 			}
-			else {
-				// Handle all errors except not supported.
-				if (status != NODE_ERROR_NOT_SUPPORTED) goto errors;
+			// Otherwise keep the record until the message is sent.
+			record = &(node_ctx.sigfox_ul_records[node_ctx.sigfox_ul_records_count]);
+			(record -> node_index) = node_index;
+			(record -> ul_payload_type) = ul_payload_type;
+			if ((ul_payload_type == NODE_SIGFOX_PAYLOAD_TYPE_DATA) && (NODES_SIGFOX_UL_SCHEDULE[board_id].data_hysteresis != NULL)) {
+				_NODE_save_data_reference(record);
 			}
-			// Increment payload type index.
-			node_ctx.sigfox_ul_payload_type_index++;
-			if (node_ctx.sigfox_ul_payload_type_index >= NODE_SIGFOX_PAYLOAD_TYPE_LAST) {
-				// Switch to next node.
-				node_ctx.sigfox_ul_payload_type_index = 0;
-				node_ctx.sigfox_ul_node_list_index++;
-				node_update_required = 1;
-				if (node_ctx.sigfox_ul_node_list_index >= NODES_LIST.count) {
-					// Come back to first node.
-					node_ctx.sigfox_ul_node_list_index = 0;
-				}
+			node_ctx.sigfox_ul_records_count++;
+		}
+		status = NODE_SUCCESS;
+		// Check if there is something to send.
+		if (node_ctx.sigfox_ul_payload_size == 0) {
+			// Downlink is requested with the next uplink.
+			bidirectional_flag = 0;
+			dl_next_time_update_required = 0;
+		}
+		else {
+			// Set radio times to now to compensate nodes update duration.
+			if (ul_next_time_update_required != 0) {
+				node_ctx.sigfox_ul_next_time_seconds = RTC_get_time_seconds();
 			}
-			// Exit if timeout.
-			loop_count++;
-			if (loop_count > NODE_SIGFOX_LOOP_MAX) {
-				status = NODE_ERROR_SIGFOX_LOOP;
-				goto errors;
+			if (dl_next_time_update_required != 0) {
+				node_ctx.sigfox_dl_next_time_seconds = RTC_get_time_seconds();
 			}
-
+			// Send data through radio (records are kept due if the message could not be sent).
+			status = _NODE_radio_send(bidirectional_flag);
+			if (status != NODE_SUCCESS) goto errors;
+			_NODE_commit_ul_records(time_seconds);
 		}
-		while (status != NODE_SUCCESS);
-	}
-	// Execute downlink operation if needed.
-	if (bidirectional_flag != 0) {
-		// Read downlink payload.
-		status = _NODE_radio_read();
-		if (status != NODE_SUCCESS) goto errors;
-		// Decode downlink payload.
-		status = _NODE_execute_downlink();
-		if (status != NODE_SUCCESS) goto errors;
 	}
+	// Defer actions and background discovery if a higher priority task is ready.
+	if (SCHEDULER_is_preemption_requested() != 0) goto errors;
 	// Execute node actions.
 	status = _NODE_execute_actions();
+	if (status != NODE_SUCCESS) goto errors;
+	// Continue background discovery.
+	status = _NODE_background_scan();
 errors:
 	// Update next radio times.
 	// This is done here in case the downlink modified one of the periods (in order to take it into account directly for next radio wake-up).
@@ -111,50 +111,34 @@ static NODE_status_t _R4S8CR_configure_phy(void) {
 	lpuart_config.baud_rate = R4S8CR_BAUD_RATE;
 	lpuart_config.rx_mode = LPUART_RX_MODE_DIRECT;
 	lpuart_config.rx_callback = &R4S8CR_fill_rx_buffer;
+	// Enable receiver as soon as the command is sent.
+	lpuart_config.tx_callback = &LPUART1_enable_rx;
 	lpuart1_status = LPUART1_configure(&lpuart_config);
 	LPUART1_status_check(NODE_ERROR_BASE_LPUART);
 errors:
 	return status;
 }
 
-/*** R4S8CR functions ***/
-
-/* READ R4S8CR NODE REGISTER.
- * @param read_params:	Pointer to the read operation parameters.
- * @param read_data:	Pointer to the read result.
+/* READ ALL RELAYS STATE OF AN R4S8CR NODE.
+ * @param node_address:	Node address.
+ * @param timeout_ms:	Reply timeout in ms.
  * @param read_status:	Pointer to the read operation status.
  * @return status:		Function execution status.
  */
-NODE_status_t R4S8CR_read_register(NODE_read_parameters_t* read_params, NODE_read_data_t* read_data, NODE_access_status_t* read_status) {
+static NODE_status_t _R4S8CR_read_relays(NODE_address_t node_address, uint32_t timeout_ms, NODE_access_status_t* read_status) {
 	// Local variables.
 	NODE_status_t status = NODE_SUCCESS;
 	LPUART_status_t lpuart1_status = LPUART_SUCCESS;
 	LPTIM_status_t lptim1_status = LPTIM_SUCCESS;
 	uint32_t reply_time_ms = 0;
 	uint8_t relay_box_id = 0;
-	// Check parameters.
-	if ((read_params == NULL) || (read_data == NULL) || (read_status == NULL)) {
-		status = NODE_ERROR_NULL_PARAMETER;
-		goto errors;
-	}
-	if ((read_params -> format) != STRING_FORMAT_BOOLEAN) {
-		status = NODE_ERROR_REGISTER_FORMAT;
-		goto errors;
-	}
-	if ((read_params -> type) != NODE_REPLY_TYPE_VALUE) {
-		status = NODE_ERROR_READ_TYPE;
-		goto errors;
-	}
-	if ((read_params -> register_address) >= R4S8CR_REGISTER_LAST) {
-		status = NODE_ERROR_REGISTER_ADDRESS;
-		goto errors;
-	}
-	if (((read_params -> node_address) < DINFOX_NODE_ADDRESS_R4S8CR_START) || ((read_params -> node_address) >= (DINFOX_NODE_ADDRESS_R4S8CR_START + DINFOX_NODE_ADDRESS_RANGE_R4S8CR))) {
+	// Check address.
+	if ((node_address < DINFOX_NODE_ADDRESS_R4S8CR_START) || (node_address >= (DINFOX_NODE_ADDRESS_R4S8CR_START + DINFOX_NODE_ADDRESS_RANGE_R4S8CR))) {
 		status = NODE_ERROR_NODE_ADDRESS;
 		goto errors;
 	}
 	// Convert node address to ID.
-	relay_box_id = ((read_params -> node_address) - DINFOX_NODE_ADDRESS_R4S8CR_START + 1) & 0x0F;
+	relay_box_id = (node_address - DINFOX_NODE_ADDRESS_R4S8CR_START + 1) & 0x0F;
 	// Flush buffers and status.
 	_R4S8CR_flush_buffers();
 	(read_status -> all) = 0;
@@ -170,8 +154,6 @@ NODE_status_t R4S8CR_read_register(NODE_read_parameters_t* read_params, NODE_rea
 	// Send command.
 	lpuart1_status = LPUART1_send(r4s8cr_ctx.command, r4s8cr_ctx.command_size);
 	LPUART1_status_check(NODE_ERROR_BASE_LPUART);
-	// Enable reception.
-	LPUART1_enable_rx();
 	// Wait reply.
 	while (1) {
 		// Delay.
@@ -179,13 +161,9 @@ NODE_status_t R4S8CR_read_register(NODE_read_parameters_t* read_params, NODE_rea
 		LPTIM1_status_check(NODE_ERROR_BASE_LPTIM);
 		reply_time_ms += R4S8CR_REPLY_PARSING_DELAY_MS;
 		// Check number of received bytes.
-		if (r4s8cr_ctx.reply_size >= R4S8CR_REPLY_SIZE_BYTES) {
-			// Update value.
-			(read_data -> value) = r4s8cr_ctx.reply[(read_params -> register_address) + R4S8CR_REPLY_SIZE_BYTES - R4S8CR_REGISTER_LAST];
-			break;
-		}
+		if (r4s8cr_ctx.reply_size >= R4S8CR_REPLY_SIZE_BYTES) break;
 		// Exit if timeout.
-		if (reply_time_ms > (read_params -> timeout_ms)) {
+		if (reply_time_ms > timeout_ms) {
 			// Set status to timeout.
 			(read_status -> reply_timeout) = 1;
 			break;
@@ -195,6 +173,82 @@ errors:
 	return status;
 }
 
+/*** R4S8CR functions ***/
+
+/* READ R4S8CR NODE REGISTER.
+ * @param read_params:	Pointer to the read operation parameters.
+ * @param read_data:	Pointer to the read result.
+ * @param read_status:	Pointer to the read operation status.
+ * @return status:		Function execution status.
+ */
+NODE_status_t R4S8CR_read_register(NODE_read_parameters_t* read_params, NODE_read_data_t* read_data, NODE_access_status_t* read_status) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	// Check parameters.
+	if ((read_params == NULL) || (read_data == NULL) || (read_status == NULL)) {
+		status = NODE_ERROR_NULL_PARAMETER;
+		goto errors;
+	}
+	if ((read_params -> format) != STRING_FORMAT_BOOLEAN) {
+		status = NODE_ERROR_REGISTER_FORMAT;
+		goto errors;
+	}
+	if ((read_params -> type) != NODE_REPLY_TYPE_VALUE) {
+		status = NODE_ERROR_READ_TYPE;
+		goto errors;
+	}
+	if ((read_params -> register_address) >= R4S8CR_REGISTER_LAST) {
+		status = NODE_ERROR_REGISTER_ADDRESS;
+		goto errors;
+	}
+	// Read relays.
+	status = _R4S8CR_read_relays((read_params -> node_address), (read_params -> timeout_ms), read_status);
+	if (status != NODE_SUCCESS) goto errors;
+	// Update value.
+	if ((read_status -> all) == 0) {
+		(read_data -> value) = r4s8cr_ctx.reply[(read_params -> register_address) + R4S8CR_REPLY_SIZE_BYTES - R4S8CR_REGISTER_LAST];
+	}
+errors:
+	return status;
+}
+
+/* READ SEVERAL R4S8CR NODE REGISTERS WITH A SINGLE COMMAND.
+ * @param read_params:	Pointer to the burst read operation parameters.
+ * @param read_data:	Pointer to the registers value and status tables.
+ * @return status:		Function execution status.
+ */
+NODE_status_t R4S8CR_read_registers(NODE_burst_read_parameters_t* read_params, NODE_burst_read_data_t* read_data) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	NODE_access_status_t read_status;
+	uint8_t register_address = 0;
+	// Check parameters.
+	if ((read_params == NULL) || (read_data == NULL)) {
+		status = NODE_ERROR_NULL_PARAMETER;
+		goto errors;
+	}
+	if (((read_data -> value) == NULL) || ((read_data -> status) == NULL)) {
+		status = NODE_ERROR_NULL_PARAMETER;
+		goto errors;
+	}
+	if (((read_params -> register_address) + (read_params -> number_of_registers)) > R4S8CR_REGISTER_LAST) {
+		status = NODE_ERROR_REGISTER_ADDRESS;
+		goto errors;
+	}
+	// The read reply contains all relays state.
+	status = _R4S8CR_read_relays((read_params -> node_address), (read_params -> timeout_ms), &read_status);
+	if (status != NODE_SUCCESS) goto errors;
+	// Registers loop.
+	for (register_address=(read_params -> register_address) ; register_address<((read_params -> register_address) + (read_params -> number_of_registers)) ; register_address++) {
+		(read_data -> status)[register_address] = read_status;
+		if (read_status.all == 0) {
+			(read_data -> value)[register_address] = r4s8cr_ctx.reply[register_address + R4S8CR_REPLY_SIZE_BYTES - R4S8CR_REGISTER_LAST];
+		}
+	}
+errors:
+	return status;
+}
+
 /* WRITE R4S8CR NODE REGISTER.
  * @param write_params:	Pointer to the write operation parameters.
  * @param write_status:	Pointer to the write operation status.
@@ -242,57 +296,80 @@ NODE_status_t R4S8CR_write_register(NODE_write_parameters_t* write_params, NODE_
 	// Send command.
 	lpuart1_status = LPUART1_send(r4s8cr_ctx.command, r4s8cr_ctx.command_size);
 	LPUART1_status_check(NODE_ERROR_BASE_LPUART);
-	// Enable reception.
-	LPUART1_enable_rx();
 errors:
 	return status;
 }
 
-/* SCAN R4S8CR NODES ON BUS.
- * @param nodes_list:		Node list to fill.
- * @param nodes_list_size:	Maximum size of the list.
- * @param nodes_count:		Pointer to byte that will contain the number of LBUS nodes detected.
- * @return status:			Function execution status.
+/* PROBE AN R4S8CR NODE.
+ * @param node_address:	Address to probe.
+ * @param node:			Pointer to the node structure that will contain the address and board ID if found.
+ * @param node_found:	Pointer to byte that will contain 1 if a node replied at this address, 0 otherwise.
+ * @return status:		Function execution status.
  */
-NODE_status_t R4S8CR_scan(NODE_t* nodes_list, uint8_t nodes_list_size, uint8_t* nodes_count) {
+NODE_status_t R4S8CR_probe(NODE_address_t node_address, NODE_t* node, uint8_t* node_found) {
 	// Local variables.
 	NODE_status_t status = NODE_SUCCESS;
 	NODE_read_parameters_t read_params;
 	NODE_read_data_t read_data;
 	NODE_access_status_t read_status;
-	NODE_address_t node_address = 0;
-	uint8_t node_list_idx = 0;
 	// Check parameters.
-	if ((nodes_list == NULL) || (nodes_count == NULL)) {
+	if ((node == NULL) || (node_found == NULL)) {
 		status = NODE_ERROR_NULL_PARAMETER;
 		goto errors;
 	}
-	// Reset count.
-	(*nodes_count) = 0;
-	// Build read input common parameters.
-	read_params.format = STRING_FORMAT_BOOLEAN;
-	read_params.timeout_ms = R4S8CR_TIMEOUT_MS;
+	(*node_found) = 0;
+	// Build read input parameters.
+	read_params.node_address = node_address;
 	read_params.register_address = R4S8CR_REGISTER_RELAY_1;
 	read_params.type = NODE_REPLY_TYPE_VALUE;
+	read_params.timeout_ms = R4S8CR_TIMEOUT_MS;
+	read_params.format = STRING_FORMAT_BOOLEAN;
 	// Configure read data.
 	read_data.raw = NULL;
 	read_data.value = 0;
 	read_data.byte_array = NULL;
 	read_data.extracted_length = 0;
+	// Read first relay.
+	status = R4S8CR_read_register(&read_params, &read_data, &read_status);
+	if (status != NODE_SUCCESS) goto errors;
+	// Check reply status.
+	if (read_status.all == 0) {
+		(*node_found) = 1;
+		(node -> address) = node_address;
+		(node -> board_id) = DINFOX_BOARD_ID_R4S8CR;
+	}
+errors:
+	return status;
+}
+
+/* SCAN R4S8CR NODES ON BUS.
+ * @param nodes_list:		Node list to fill.
+ * @param nodes_list_size:	Maximum size of the list.
+ * @param nodes_count:		Pointer to byte that will contain the number of LBUS nodes detected.
+ * @return status:			Function execution status.
+ */
+NODE_status_t R4S8CR_scan(NODE_t* nodes_list, uint8_t nodes_list_size, uint8_t* nodes_count) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	NODE_address_t node_address = 0;
+	uint8_t node_found = 0;
+	// Check parameters.
+	if ((nodes_list == NULL) || (nodes_count == NULL)) {
+		status = NODE_ERROR_NULL_PARAMETER;
+		goto errors;
+	}
+	// Reset count.
+	(*nodes_count) = 0;
 	// Loop on all addresses.
 	for (node_address=DINFOX_NODE_ADDRESS_R4S8CR_START ; node_address<(DINFOX_NODE_ADDRESS_R4S8CR_START + DINFOX_NODE_ADDRESS_RANGE_R4S8CR) ; node_address++) {
-		// Update read parameters.
-		read_params.node_address = node_address;
-		// Ping address.
-		status = R4S8CR_read_register(&read_params, &read_data, &read_status);
+		// Check index.
+		if ((*nodes_count) >= nodes_list_size) break;
+		// Probe address.
+		status = R4S8CR_probe(node_address, &(nodes_list[*nodes_count]), &node_found);
 		if (status != NODE_SUCCESS) goto errors;
-		// Check reply status.
-		if (read_status.all == 0) {
-			// Node found.
+		// Update count.
+		if (node_found != 0) {
 			(*nodes_count)++;
-			// Store address and reset board ID.
-			nodes_list[node_list_idx].address = node_address;
-			nodes_list[node_list_idx].board_id = DINFOX_BOARD_ID_R4S8CR;
 		}
 	}
 errors:
@@ -307,16 +384,13 @@ NODE_status_t R4S8CR_update_data(NODE_data_update_t* data_update) {
 	// Local variables.
 	NODE_status_t status = NODE_SUCCESS;
 	STRING_status_t string_status = STRING_SUCCESS;
-	NODE_read_parameters_t read_params;
-	NODE_read_data_t read_data;
-	NODE_access_status_t read_status;
 	uint8_t buffer_size = 0;
 	// Check parameters.
 	if (data_update == NULL) {
 		status = NODE_ERROR_NULL_PARAMETER;
 		goto errors;
 	}
-	if (((data_update -> name_ptr) == NULL) || ((data_update -> value_ptr) == NULL) || ((data_update -> registers_value_ptr) == NULL)) {
+	if (((data_update -> name_ptr) == NULL) || ((data_update -> value_ptr) == NULL) || ((data_update -> registers_value_ptr) == NULL) || ((data_update -> registers_status_ptr) == NULL)) {
 		status = NODE_ERROR_NULL_PARAMETER;
 		goto errors;
 	}
@@ -325,28 +399,12 @@ NODE_status_t R4S8CR_update_data(NODE_data_update_t* data_update) {
 		status = NODE_ERROR_STRING_DATA_INDEX;
 		goto errors;
 	}
-	// Common read input parameters.
-	read_params.node_address = (data_update -> node_address);
-	read_params.register_address = (data_update -> string_data_index);
-	read_params.type = NODE_REPLY_TYPE_VALUE;
-	read_params.timeout_ms = R4S8CR_TIMEOUT_MS;
-	read_params.format = STRING_FORMAT_BOOLEAN;
-	// Configure read data.
-	read_data.raw = NULL;
-	read_data.value = 0;
-	read_data.byte_array = NULL;
-	read_data.extracted_length = 0;
-	// Read data.
-	status = R4S8CR_read_register(&read_params, &read_data, &read_status);
-	if (status != NODE_SUCCESS) goto errors;
 	// Add data name.
 	NODE_append_string_name((char_t*) R4S8CR_STRING_DATA_NAME[(data_update -> string_data_index)]);
 	buffer_size = 0;
 	// Add data value.
-	if (read_status.all == 0) {
-		// Update integer data.
-		NODE_update_value((data_update -> string_data_index), read_data.value);
-		NODE_append_string_value((read_data.value == 0) ? "OFF" : "ON");
+	if ((data_update -> registers_status_ptr)[data_update -> string_data_index].all == 0) {
+		NODE_append_string_value(((data_update -> registers_value_ptr)[data_update -> string_data_index] == 0) ? "OFF" : "ON");
 	}
 	else {
 		NODE_flush_string_value();
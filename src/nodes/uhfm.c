@@ -20,7 +20,7 @@
 #define UHFM_COMMAND_READ_DL_PAYLOAD			"AT$DL?"
 
 #define UHFM_SEND_COMMAND_TIMEOUT_MS_UPLINK		10000
-#define UHFM_SEND_COMMAND_TIMEOUT_MS_DOWNLINK	60000
+#define UHFM_SEND_COMMAND_TIMEOUT_MS_DOWNLINK	(UHFM_SIGFOX_DOWNLINK_DURATION_SECONDS * 1000)
 
 static const char_t* UHFM_STRING_DATA_NAME[UHFM_NUMBER_OF_SPECIFIC_STRING_DATA] = {
 	"VRF ="
@@ -53,9 +53,6 @@ NODE_status_t UHFM_update_data(NODE_data_update_t* data_update) {
 	// Local variables.
 	NODE_status_t status = NODE_SUCCESS;
 	STRING_status_t string_status = STRING_SUCCESS;
-	NODE_read_parameters_t read_params;
-	NODE_read_data_t read_data;
-	NODE_access_status_t read_status;
 	uint8_t register_address = 0;
 	uint8_t buffer_size = 0;
 	// Check parameters.
@@ -63,7 +60,7 @@ NODE_status_t UHFM_update_data(NODE_data_update_t* data_update) {
 		status = NODE_ERROR_NULL_PARAMETER;
 		goto errors;
 	}
-	if (((data_update -> name_ptr) == NULL) || ((data_update -> value_ptr) == NULL) || ((data_update -> registers_value_ptr) == NULL)) {
+	if (((data_update -> name_ptr) == NULL) || ((data_update -> value_ptr) == NULL) || ((data_update -> registers_value_ptr) == NULL) || ((data_update -> registers_status_ptr) == NULL)) {
 		status = NODE_ERROR_NULL_PARAMETER;
 		goto errors;
 	}
@@ -74,36 +71,20 @@ NODE_status_t UHFM_update_data(NODE_data_update_t* data_update) {
 	}
 	// Convert to register address.
 	register_address = ((data_update -> string_data_index) + DINFOX_REGISTER_LAST - DINFOX_STRING_DATA_INDEX_LAST);
-	// Read parameters.
-	read_params.node_address = (data_update -> node_address);
-	read_params.register_address = register_address;
-	read_params.type = NODE_REPLY_TYPE_VALUE;
-	read_params.timeout_ms = AT_BUS_DEFAULT_TIMEOUT_MS;
-	read_params.format = STRING_FORMAT_DECIMAL;
-	// Configure read data.
-	read_data.raw = NULL;
-	read_data.value = 0;
-	read_data.byte_array = NULL;
-	read_data.extracted_length = 0;
-	// Read data.
-	status = AT_BUS_read_register(&read_params, &read_data, &read_status);
-	if (status != NODE_SUCCESS) goto errors;
 	// Add data name.
 	NODE_append_string_name((char_t*) UHFM_STRING_DATA_NAME[(data_update -> string_data_index) - DINFOX_STRING_DATA_INDEX_LAST]);
 	buffer_size = 0;
 	// Add data value.
-	if (read_status.all == 0) {
+	if ((data_update -> registers_status_ptr)[register_address].all == 0) {
 		// Add value.
-		NODE_append_string_value(read_data.raw);
+		NODE_append_string_value_int32((data_update -> registers_value_ptr)[register_address], UHFM_REGISTERS_FORMAT[register_address - DINFOX_REGISTER_LAST], 0);
 		// Add unit.
 		NODE_append_string_value((char_t*) UHFM_STRING_DATA_UNIT[(data_update -> string_data_index) - DINFOX_STRING_DATA_INDEX_LAST]);
-		// Update integer data.
-		NODE_update_value(register_address, read_data.value);
 	}
 	else {
 		NODE_flush_string_value();
 		NODE_append_string_value((char_t*) NODE_ERROR_STRING);
-		NODE_update_value(register_address, UHFM_ERROR_VALUE[register_address]);
+		NODE_update_value(register_address, UHFM_ERROR_VALUE[register_address - DINFOX_REGISTER_LAST]);
 	}
 errors:
 	return status;
@@ -152,29 +133,25 @@ errors:
 	return status;
 }
 
-/* SEND SIGFOX MESSAGE WITH UHFM MODULE.
- * @param node_address:		Address of the UHFM node to use.
+/* BUILD SIGFOX SEND COMMAND.
  * @param sigfox_message:	Pointer to the Sigfox message structure.
- * @param send_status:		Pointer to the sending status.
+ * @param command:			Command buffer to fill.
  * @return status:			Function execution status.
  */
-NODE_status_t UHFM_send_sigfox_message(NODE_address_t node_address, UHFM_sigfox_message_t* sigfox_message, NODE_access_status_t* send_status) {
+static NODE_status_t _UHFM_build_send_command(UHFM_sigfox_message_t* sigfox_message, char_t* command) {
 	// Local variables.
 	NODE_status_t status = NODE_SUCCESS;
 	STRING_status_t string_status = STRING_SUCCESS;
-	NODE_command_parameters_t command_params;
-	NODE_reply_parameters_t reply_params;
-	NODE_read_data_t unused_read_data;
-	char_t command[UHFM_COMMAND_BUFFER_SIZE_BYTES] = {STRING_CHAR_NULL};
 	uint8_t command_size = 0;
 	uint8_t idx = 0;
-	uint32_t timeout_ms = 0;
+	// Check parameter.
+	if (sigfox_message == NULL) {
+		status = NODE_ERROR_NULL_PARAMETER;
+		goto errors;
+	}
 	// Build command.
 	string_status = STRING_append_string(command, UHFM_COMMAND_BUFFER_SIZE_BYTES, UHFM_COMMAND_SEND, &command_size);
 	STRING_status_check(NODE_ERROR_BASE_STRING);
-	// Set command parameters.
-	command_params.node_address = node_address;
-	command_params.command = (char_t*) command;
 	// UL payload bytes loop.
 	for (idx=0 ; idx<(sigfox_message -> ul_payload_size) ; idx++) {
 		string_status = STRING_append_value(command, UHFM_COMMAND_BUFFER_SIZE_BYTES, (sigfox_message -> ul_payload)[idx], STRING_FORMAT_HEXADECIMAL, 0, &command_size);
@@ -185,16 +162,65 @@ NODE_status_t UHFM_send_sigfox_message(NODE_address_t node_address, UHFM_sigfox_
 		// Append parameter.
 		string_status = STRING_append_string(command, UHFM_COMMAND_BUFFER_SIZE_BYTES, ",1", &command_size);
 		STRING_status_check(NODE_ERROR_BASE_STRING);
-		// Update timeout.
-		timeout_ms = UHFM_SEND_COMMAND_TIMEOUT_MS_DOWNLINK;
-	}
-	else {
-		timeout_ms = UHFM_SEND_COMMAND_TIMEOUT_MS_UPLINK;
 	}
+errors:
+	return status;
+}
+
+/* SEND SIGFOX MESSAGE WITH UHFM MODULE.
+ * @param node_address:		Address of the UHFM node to use.
+ * @param sigfox_message:	Pointer to the Sigfox message structure.
+ * @param send_status:		Pointer to the sending status.
+ * @return status:			Function execution status.
+ */
+NODE_status_t UHFM_send_sigfox_message(NODE_address_t node_address, UHFM_sigfox_message_t* sigfox_message, NODE_access_status_t* send_status) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	NODE_command_parameters_t command_params;
+	NODE_reply_parameters_t reply_params;
+	NODE_read_data_t unused_read_data;
+	char_t command[UHFM_COMMAND_BUFFER_SIZE_BYTES] = {STRING_CHAR_NULL};
+	// Build command.
+	status = _UHFM_build_send_command(sigfox_message, command);
+	if (status != NODE_SUCCESS) goto errors;
+	// Set command parameters.
+	command_params.node_address = node_address;
+	command_params.command = (char_t*) command;
 	// Build reply structure.
 	reply_params.type = NODE_REPLY_TYPE_OK;
 	reply_params.format = STRING_FORMAT_BOOLEAN;
-	reply_params.timeout_ms = timeout_ms;
+	reply_params.timeout_ms = ((sigfox_message -> bidirectional_flag) != 0) ? UHFM_SEND_COMMAND_TIMEOUT_MS_DOWNLINK : UHFM_SEND_COMMAND_TIMEOUT_MS_UPLINK;
+	reply_params.byte_array_size = 0;
+	reply_params.exact_length = 0;
+	// Send command.
+	status = AT_BUS_send_command(&command_params, &reply_params, &unused_read_data, send_status);
+errors:
+	return status;
+}
+
+/* START SIGFOX MESSAGE WITH UHFM MODULE WITHOUT WAITING FOR THE END OF TRANSMISSION.
+ * @param node_address:		Address of the UHFM node to use.
+ * @param sigfox_message:	Pointer to the Sigfox message structure.
+ * @param send_status:		Pointer to the command acknowledgement status.
+ * @return status:			Function execution status.
+ */
+NODE_status_t UHFM_start_sigfox_message(NODE_address_t node_address, UHFM_sigfox_message_t* sigfox_message, NODE_access_status_t* send_status) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	NODE_command_parameters_t command_params;
+	NODE_reply_parameters_t reply_params;
+	NODE_read_data_t unused_read_data;
+	char_t command[UHFM_COMMAND_BUFFER_SIZE_BYTES] = {STRING_CHAR_NULL};
+	// Build command.
+	status = _UHFM_build_send_command(sigfox_message, command);
+	if (status != NODE_SUCCESS) goto errors;
+	// Set command parameters.
+	command_params.node_address = node_address;
+	command_params.command = (char_t*) command;
+	// Only wait for the command acknowledgement: the result is checked afterwards by polling the downlink payload.
+	reply_params.type = NODE_REPLY_TYPE_OK;
+	reply_params.format = STRING_FORMAT_BOOLEAN;
+	reply_params.timeout_ms = AT_BUS_DEFAULT_TIMEOUT_MS;
 	reply_params.byte_array_size = 0;
 	reply_params.exact_length = 0;
 	// Send command.
@@ -203,7 +229,7 @@ errors:
 	return status;
 }
 
-/* READ DOWNLINK PAYLOAD.
+/* READ DOWNLINK PAYLOAD (AN ERROR IS RETURNED AS LONG AS THE DOWNLINK IS NOT AVAILABLE).
  * @param node_address:	Address of the UHFM node to use.
  * @param dl_payload:	Byte array that will contain the DL payload.
  * @param send_status:	Pointer to the read status.
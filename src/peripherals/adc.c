@@ -8,18 +8,27 @@
 #include "adc.h"
 
 #include "adc_reg.h"
+#include "dma.h"
 #include "gpio.h"
 #include "lptim.h"
 #include "mapping.h"
 #include "math.h"
+#include "pwr.h"
 #include "rcc_reg.h"
 #include "types.h"
 
 /*** ADC local macros ***/
 
+//#define ADC_MEDIAN_FILTER				// Repeat the whole sequence and apply a median filter on each channel if defined.
 #define ADC_MEDIAN_FILTER_LENGTH		9
 #define ADC_CENTER_AVERAGE_LENGTH		3
 
+#define ADC_SEQUENCE_CHANNELS			((0b1 << ADC_CHANNEL_VUSB) | (0b1 << ADC_CHANNEL_VHMI) | (0b1 << ADC_CHANNEL_VRS) | (0b1 << ADC_CHANNEL_VREFINT) | (0b1 << ADC_CHANNEL_TMCU))
+#define ADC_SEQUENCE_LENGTH				5
+
+#define ADC_OVERSAMPLING_RATIO			0b010 // 8 samples.
+#define ADC_OVERSAMPLING_SHIFT			0b0011 // Division by 8 to keep 12-bits results.
+
 #define ADC_FULL_SCALE_12BITS			4095
 
 #define ADC_VREFINT_VOLTAGE_MV			((VREFINT_CAL * VREFINT_VCC_CALIB_MV) / (ADC_FULL_SCALE_12BITS))
@@ -27,6 +36,8 @@
 
 #define ADC_TIMEOUT_COUNT				1000000
 
+#define ADC_STATISTICS_WINDOW_DEFAULT	60 // Number of measurements.
+
 /*** ADC local structures ***/
 
 typedef enum {
@@ -52,9 +63,13 @@ typedef struct {
 } ADC_input_t;
 
 typedef struct {
+	uint16_t sequence_buffer[ADC_SEQUENCE_LENGTH]; // Filled by DMA in channels order.
+	uint32_t sequence_12bits[ADC_SEQUENCE_LENGTH];
 	uint32_t vrefint_12bits;
 	uint32_t data[ADC_DATA_INDEX_LAST];
 	int8_t tmcu_degrees;
+	MATH_statistics_t statistics[ADC_DATA_INDEX_LAST];
+	uint16_t statistics_window;
 } ADC_context_t;
 
 /*** ADC local global variables ***/
@@ -69,96 +84,105 @@ static ADC_context_t adc_ctx;
 
 /*** ADC local functions ***/
 
-/* PERFORM A SINGLE ADC CONVERSION.
- * @param adc_channel:			Channel to convert.
- * @param adc_result_12bits:	Pointer to 32-bits value that will contain ADC raw result on 12 bits.
- * @return status:				Function execution status.
+/* GET THE RANK OF A CHANNEL IN THE CONVERSION SEQUENCE.
+ * @param adc_channel:	Channel to search.
+ * @return rank:		Index of the channel result in the sequence buffer.
+ */
+static uint8_t _ADC1_get_sequence_rank(ADC_channel_t adc_channel) {
+	// Local variables.
+	uint8_t rank = 0;
+	uint8_t idx = 0;
+	// Channels are converted in ascending order (SCANDIR='0').
+	for (idx=0 ; idx<adc_channel ; idx++) {
+		if ((ADC_SEQUENCE_CHANNELS & (0b1 << idx)) != 0) rank++;
+	}
+	return rank;
+}
+
+/* PERFORM ONE OVERSAMPLED CONVERSION OF ALL CHANNELS.
+ * @param:			None.
+ * @return status:	Function execution status.
  */
-static ADC_status_t _ADC1_single_conversion(ADC_channel_t adc_channel, uint32_t* adc_result_12bits) {
+static ADC_status_t _ADC1_sequence_conversion(void) {
 	// Local variables.
 	ADC_status_t status = ADC_SUCCESS;
 	uint32_t loop_count = 0;
-	// Check parameters.
-	if (adc_channel >= ADC_CHANNEL_LAST) {
-		status = ADC_ERROR_CHANNEL;
-		goto errors;
-	}
-	if (adc_result_12bits == NULL) {
-		status = ADC_ERROR_NULL_PARAMETER;
-		goto errors;
-	}
-	// Select input channel.
-	ADC1 -> CHSELR &= 0xFFF80000; // Reset all bits.
-	ADC1 -> CHSELR |= (0b1 << adc_channel);
+	// Configure and start DMA.
+	DMA1_CH1_set_destination_address((uint32_t) adc_ctx.sequence_buffer, ADC_SEQUENCE_LENGTH);
+	DMA1_CH1_start();
 	// Clear all flags.
 	ADC1 -> ISR |= 0x0000089F;
-	// Read raw supply voltage.
+	// Start sequence.
 	ADC1 -> CR |= (0b1 << 2); // ADSTART='1'.
-	while (((ADC1 -> ISR) & (0b1 << 2)) == 0) {
-		// Wait end of conversion ('EOC='1') or timeout.
+	// Sleep until all results have been transferred.
+	while (DMA1_CH1_get_transfer_status() == 0) {
+		PWR_enter_sleep_mode();
 		loop_count++;
 		if (loop_count > ADC_TIMEOUT_COUNT) {
 			status = ADC_ERROR_TIMEOUT;
 			goto errors;
 		}
 	}
-	(*adc_result_12bits) = (ADC1 -> DR);
 errors:
+	DMA1_CH1_stop();
 	return status;
 }
 
-/* PERFORM SEVERAL CONVERSIONS FOLLOWED BY A MEDIAN FILTER.
- * @param adc_channel:			Channel to convert.
- * @param adc_result_12bits:	Pointer to 32-bits value that will contain ADC filtered result on 12 bits.
- * @return status:				Function execution status.
+/* PERFORM FILTERED CONVERSIONS OF ALL CHANNELS.
+ * @param:			None.
+ * @return status:	Function execution status.
  */
-static ADC_status_t _ADC1_filtered_conversion(ADC_channel_t adc_channel, uint32_t* adc_result_12bits) {
+static ADC_status_t _ADC1_filtered_conversion(void) {
 	// Local variables.
 	ADC_status_t status = ADC_SUCCESS;
+#ifdef ADC_MEDIAN_FILTER
 	MATH_status_t math_status = MATH_SUCCESS;
-	uint32_t adc_sample_buf[ADC_MEDIAN_FILTER_LENGTH] = {0x00};
+	uint32_t adc_sample_buf[ADC_SEQUENCE_LENGTH][ADC_MEDIAN_FILTER_LENGTH];
+	uint8_t sample_idx = 0;
+#endif
 	uint8_t idx = 0;
-	// Check parameters.
-	if (adc_channel >= ADC_CHANNEL_LAST) {
-		status = ADC_ERROR_CHANNEL;
-		goto errors;
+#ifdef ADC_MEDIAN_FILTER
+	// Perform all sequences.
+	for (sample_idx=0 ; sample_idx<ADC_MEDIAN_FILTER_LENGTH ; sample_idx++) {
+		status = _ADC1_sequence_conversion();
+		if (status != ADC_SUCCESS) goto errors;
+		for (idx=0 ; idx<ADC_SEQUENCE_LENGTH ; idx++) {
+			adc_sample_buf[idx][sample_idx] = (uint32_t) adc_ctx.sequence_buffer[idx];
+		}
 	}
-	if (adc_result_12bits == NULL) {
-		status = ADC_ERROR_NULL_PARAMETER;
-		goto errors;
+	// Apply median filter on each channel.
+	for (idx=0 ; idx<ADC_SEQUENCE_LENGTH ; idx++) {
+		math_status = MATH_median_filter_u32(adc_sample_buf[idx], ADC_MEDIAN_FILTER_LENGTH, ADC_CENTER_AVERAGE_LENGTH, &(adc_ctx.sequence_12bits[idx]));
+		MATH_status_check(ADC_ERROR_BASE_MATH);
 	}
-	// Perform all conversions.
-	for (idx=0 ; idx<ADC_MEDIAN_FILTER_LENGTH ; idx++) {
-		status = _ADC1_single_conversion(adc_channel, &(adc_sample_buf[idx]));
-		if (status != ADC_SUCCESS) goto errors;
+#else
+	// Hardware oversampling is enough.
+	status = _ADC1_sequence_conversion();
+	if (status != ADC_SUCCESS) goto errors;
+	for (idx=0 ; idx<ADC_SEQUENCE_LENGTH ; idx++) {
+		adc_ctx.sequence_12bits[idx] = (uint32_t) adc_ctx.sequence_buffer[idx];
 	}
-	// Apply median filter.
-	math_status = MATH_median_filter_u32(adc_sample_buf, ADC_MEDIAN_FILTER_LENGTH, ADC_CENTER_AVERAGE_LENGTH, adc_result_12bits);
-	MATH_status_check(ADC_ERROR_BASE_MATH);
+#endif
 errors:
 	return status;
 }
 
 /* COMPUTE MCU TEMPERATURE THANKS TO INTERNAL VOLTAGE REFERENCE.
- * @param:			None.
- * @return status:	Function execution status.
+ * @param:	None.
+ * @return:	None.
  */
-static ADC_status_t _ADC1_compute_tmcu(void) {
+static void _ADC1_compute_tmcu(void) {
 	// Local variables.
-	ADC_status_t status = ADC_SUCCESS;
 	uint32_t raw_temp_sensor_12bits = 0;
 	int32_t raw_temp_calib_mv = 0;
 	int32_t temp_calib_degrees = 0;
 	// Read raw temperature.
-	status = _ADC1_filtered_conversion(ADC_CHANNEL_TMCU, &raw_temp_sensor_12bits);
-	if (status != ADC_SUCCESS) goto errors;
+	raw_temp_sensor_12bits = adc_ctx.sequence_12bits[_ADC1_get_sequence_rank(ADC_CHANNEL_TMCU)];
 	// Compute temperature according to MCU factory calibration (see p.301 and p.847 of RM0377 datasheet).
 	raw_temp_calib_mv = ((int32_t) raw_temp_sensor_12bits * adc_ctx.data[ADC_DATA_INDEX_VMCU_MV]) / (TS_VCC_CALIB_MV) - TS_CAL1; // Equivalent raw measure for calibration power supply (VCC_CALIB).
 	temp_calib_degrees = raw_temp_calib_mv * ((int32_t) (TS_CAL2_TEMP-TS_CAL1_TEMP));
 	temp_calib_degrees = (temp_calib_degrees) / ((int32_t) (TS_CAL2 - TS_CAL1));
 	adc_ctx.tmcu_degrees = temp_calib_degrees + TS_CAL1_TEMP;
-errors:
-	return status;
 }
 
 /* COMPUTE ALL ADC CHANNELS.
@@ -170,11 +194,13 @@ static ADC_status_t _ADC1_compute_all_channels(void) {
 	ADC_status_t status = ADC_SUCCESS;
 	uint8_t idx = 0;
 	uint32_t voltage_12bits = 0;
+	// Convert all channels at once.
+	status = _ADC1_filtered_conversion();
+	if (status != ADC_SUCCESS) goto errors;
 	// Channels loop.
 	for (idx=0 ; idx<ADC_DATA_INDEX_LAST ; idx++) {
 		// Get raw result.
-		status = _ADC1_filtered_conversion(ADC_INPUTS[idx].channel, &voltage_12bits);
-		if (status != ADC_SUCCESS) goto errors;
+		voltage_12bits = adc_ctx.sequence_12bits[_ADC1_get_sequence_rank(ADC_INPUTS[idx].channel)];
 		// Update VREFINT.
 		if (ADC_INPUTS[idx].channel == ADC_CHANNEL_VREFINT) {
 			adc_ctx.vrefint_12bits = voltage_12bits;
@@ -200,6 +226,29 @@ errors:
 	return status;
 }
 
+/* ADD LAST MEASUREMENTS TO THE RUNNING STATISTICS.
+ * @param:			None.
+ * @return status:	Function execution status.
+ */
+static ADC_status_t _ADC1_update_statistics(void) {
+	// Local variables.
+	ADC_status_t status = ADC_SUCCESS;
+	MATH_status_t math_status = MATH_SUCCESS;
+	uint8_t idx = 0;
+	// Channels loop.
+	for (idx=0 ; idx<ADC_DATA_INDEX_LAST ; idx++) {
+		// Start a new window when the current one is complete.
+		if (adc_ctx.statistics[idx].count >= adc_ctx.statistics_window) {
+			math_status = MATH_statistics_reset(&(adc_ctx.statistics[idx]));
+			MATH_status_check(ADC_ERROR_BASE_MATH);
+		}
+		math_status = MATH_statistics_add(&(adc_ctx.statistics[idx]), (int32_t) adc_ctx.data[idx]);
+		MATH_status_check(ADC_ERROR_BASE_MATH);
+	}
+errors:
+	return status;
+}
+
 /*** ADC functions ***/
 
 /* INIT ADC1 PERIPHERAL.
@@ -217,6 +266,8 @@ ADC_status_t ADC1_init(void) {
 	for (idx=0 ; idx<ADC_DATA_INDEX_LAST ; idx++) adc_ctx.data[idx] = 0;
 	adc_ctx.data[ADC_DATA_INDEX_VMCU_MV] = ADC_VMCU_DEFAULT_MV;
 	adc_ctx.tmcu_degrees = 0;
+	for (idx=0 ; idx<ADC_DATA_INDEX_LAST ; idx++) MATH_statistics_reset(&(adc_ctx.statistics[idx]));
+	adc_ctx.statistics_window = ADC_STATISTICS_WINDOW_DEFAULT;
 	// Init GPIOs.
 	GPIO_configure(&GPIO_MNTR_EN, GPIO_MODE_OUTPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
 	GPIO_configure(&GPIO_ADC1_IN1, GPIO_MODE_ANALOG, GPIO_TYPE_OPEN_DRAIN, GPIO_SPEED_LOW, GPIO_PULL_NONE);
@@ -240,6 +291,16 @@ ADC_status_t ADC1_init(void) {
 	ADC1 -> CCR |= (0b1 << 25); // Enable low frequency clock (LFMEN='1').
 	ADC1 -> CFGR2 |= (0b11 << 30); // Use PCLK2 as ADCCLK (MSI).
 	ADC1 -> SMPR |= (0b111 << 0); // Maximum sampling time.
+	// Hardware oversampling (OVSE='1').
+	ADC1 -> CFGR2 &= ~((0b1111 << 5) | (0b111 << 2));
+	ADC1 -> CFGR2 |= (ADC_OVERSAMPLING_SHIFT << 5) | (ADC_OVERSAMPLING_RATIO << 2) | (0b1 << 0);
+	// Single sequence of all channels with DMA transfer in one shot mode (DMAEN='1', DMACFG='0', CONT='0' and SCANDIR='0').
+	ADC1 -> CFGR1 &= ~((0b1 << 13) | (0b1 << 2) | (0b1 << 1));
+	ADC1 -> CFGR1 |= (0b1 << 0);
+	ADC1 -> CHSELR &= 0xFFF80000; // Reset all bits.
+	ADC1 -> CHSELR |= ADC_SEQUENCE_CHANNELS;
+	// Init DMA channel used to transfer results.
+	DMA1_CH1_init();
 	// ADC calibration.
 	ADC1 -> CR |= (0b1 << 31); // ADCAL='1'.
 	while ((((ADC1 -> CR) & (0b1 << 31)) != 0) && (((ADC1 -> ISR) & (0b1 << 11)) == 0)) {
@@ -290,7 +351,8 @@ ADC_status_t ADC1_perform_measurements(void) {
 	// Perform conversions.
 	status = _ADC1_compute_all_channels();
 	if (status != ADC_SUCCESS) goto errors;
-	status = _ADC1_compute_tmcu();
+	_ADC1_compute_tmcu();
+	status = _ADC1_update_statistics();
 	if (status != ADC_SUCCESS) goto errors;
 errors:
 	// Switch internal voltage reference off.
@@ -343,3 +405,51 @@ ADC_status_t ADC1_get_tmcu(int8_t* tmcu_degrees) {
 errors:
 	return status;
 }
+
+/* GET RUNNING STATISTICS OF ADC DATA.
+ * @param data_idx:		Index of the data to retrieve.
+ * @param statistics:	Pointer to the statistics of the current window.
+ * @return status:		Function execution status.
+ */
+ADC_status_t ADC1_get_statistics(ADC_data_index_t data_idx, MATH_statistics_result_t* statistics) {
+	// Local variables.
+	ADC_status_t status = ADC_SUCCESS;
+	MATH_status_t math_status = MATH_SUCCESS;
+	// Check parameters.
+	if (data_idx >= ADC_DATA_INDEX_LAST) {
+		status = ADC_ERROR_DATA_INDEX;
+		goto errors;
+	}
+	math_status = MATH_statistics_get(&(adc_ctx.statistics[data_idx]), statistics);
+	MATH_status_check(ADC_ERROR_BASE_MATH);
+errors:
+	return status;
+}
+
+/* SET STATISTICS WINDOW LENGTH.
+ * @param statistics_window:	Number of measurements per window.
+ * @return status:				Function execution status.
+ */
+ADC_status_t ADC1_set_statistics_window(uint16_t statistics_window) {
+	// Local variables.
+	ADC_status_t status = ADC_SUCCESS;
+	uint8_t idx = 0;
+	// Check parameter.
+	if ((statistics_window == 0) || (statistics_window == 0xFFFF)) {
+		status = ADC_ERROR_STATISTICS_WINDOW;
+		goto errors;
+	}
+	// Update window and restart statistics.
+	adc_ctx.statistics_window = statistics_window;
+	for (idx=0 ; idx<ADC_DATA_INDEX_LAST ; idx++) MATH_statistics_reset(&(adc_ctx.statistics[idx]));
+errors:
+	return status;
+}
+
+/* GET STATISTICS WINDOW LENGTH.
+ * @param:	None.
+ * @return:	Number of measurements per window.
+ */
+uint16_t ADC1_get_statistics_window(void) {
+	return adc_ctx.statistics_window;
+}
@@ -0,0 +1,268 @@
+/*
+ * dma.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "dma.h"
+
+#include "adc_reg.h"
+#include "dma_reg.h"
+#include "i2c_reg.h"
+#include "nvic.h"
+#include "rcc_reg.h"
+#include "types.h"
+
+/*** DMA local global variables ***/
+
+static volatile uint8_t dma1_ch1_tcif = 0;
+static DMA_transfer_error_cb_t dma1_ch2_3_transfer_error_callback = NULL;
+
+/*** DMA local functions ***/
+
+/* DMA1 CHANNEL 1 INTERRUPT HANDLER.
+ * @param:	None.
+ * @return:	None.
+ */
+void __attribute__((optimize("-O0"))) DMA1_Channel1_IRQHandler(void) {
+	// Transfer complete interrupt (TCIF1='1').
+	if (((DMA1 -> ISR) & (0b1 << 1)) != 0) {
+		// Set local flag.
+		if (((DMA1 -> CCR1) & (0b1 << 1)) != 0) {
+			dma1_ch1_tcif = 1;
+		}
+		// Clear flag.
+		DMA1 -> IFCR |= (0b1 << 1); // CTCIF1='1'.
+	}
+}
+
+/* DMA1 CHANNELS 2 AND 3 INTERRUPT HANDLER.
+ * @param:	None.
+ * @return:	None.
+ */
+void __attribute__((optimize("-O0"))) DMA1_Channel2_3_IRQHandler(void) {
+	// Transfer error interrupt (TEIF2='1' or TEIF3='1').
+	if (((DMA1 -> ISR) & ((0b1 << 11) | (0b1 << 7))) != 0) {
+		// Clear flags.
+		DMA1 -> IFCR |= (0b1 << 11) | (0b1 << 7); // CTEIF3='1' and CTEIF2='1'.
+		// Notify owner.
+		if (dma1_ch2_3_transfer_error_callback != NULL) {
+			dma1_ch2_3_transfer_error_callback();
+		}
+	}
+}
+
+/*** DMA functions ***/
+
+/* CONFIGURE DMA1 CHANNEL 1 FOR ADC RESULTS TRANSFER.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_CH1_init(void) {
+	// Enable peripheral clock.
+	RCC -> AHBENR |= (0b1 << 0); // DMAEN='1'.
+	// Disable channel before configuration.
+	DMA1 -> CCR1 &= ~(0b1 << 0); // EN='0'.
+	// Memory and peripheral data size are 16 bits (MSIZE='01' and PSIZE='01').
+	DMA1 -> CCR1 &= ~((0b11 << 10) | (0b11 << 8));
+	DMA1 -> CCR1 |= (0b01 << 10) | (0b01 << 8);
+	// Memory increment mode (MINC='1'), peripheral address is fixed (PINC='0').
+	DMA1 -> CCR1 |= (0b1 << 7);
+	DMA1 -> CCR1 &= ~(0b1 << 6);
+	// Read from peripheral (DIR='0') without circular mode (CIRC='0').
+	DMA1 -> CCR1 &= ~((0b1 << 5) | (0b1 << 4));
+	// Enable transfer complete interrupt (TCIE='1').
+	DMA1 -> CCR1 |= (0b1 << 1);
+	// Peripheral address.
+	DMA1 -> CPAR1 = (uint32_t) &(ADC1 -> DR);
+	// Map channel 1 request to ADC (C1S='0000').
+	DMA1 -> CSELR &= ~(0b1111 << 0);
+	// Set interrupt priority.
+	NVIC_set_priority(NVIC_INTERRUPT_DMA1_CHA1, 1);
+}
+
+/* START DMA1 CHANNEL 1 TRANSFER.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_CH1_start(void) {
+	// Clear all flags.
+	dma1_ch1_tcif = 0;
+	DMA1 -> IFCR |= (0b1111 << 0); // CGIF1='1', CTCIF1='1', CHTIF1='1' and CTEIF1='1'.
+	// Enable interrupt.
+	NVIC_enable_interrupt(NVIC_INTERRUPT_DMA1_CHA1);
+	// Start transfer.
+	DMA1 -> CCR1 |= (0b1 << 0); // EN='1'.
+}
+
+/* STOP DMA1 CHANNEL 1 TRANSFER.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_CH1_stop(void) {
+	// Stop transfer.
+	DMA1 -> CCR1 &= ~(0b1 << 0); // EN='0'.
+	// Disable interrupt.
+	NVIC_disable_interrupt(NVIC_INTERRUPT_DMA1_CHA1);
+}
+
+/* SET DMA1 CHANNEL 1 DESTINATION BUFFER (MUST BE CALLED WHEN THE CHANNEL IS STOPPED).
+ * @param destination_buffer_addr:	Address of the buffer that will receive ADC results.
+ * @param destination_buffer_size:	Number of 16-bits results to transfer.
+ * @return:							None.
+ */
+void DMA1_CH1_set_destination_address(uint32_t destination_buffer_addr, uint16_t destination_buffer_size) {
+	// Set memory address and transfer size.
+	DMA1 -> CMAR1 = destination_buffer_addr;
+	DMA1 -> CNDTR1 = destination_buffer_size;
+}
+
+/* GET DMA1 CHANNEL 1 TRANSFER STATUS.
+ * @param:	None.
+ * @return:	1 if the transfer is complete, 0 otherwise.
+ */
+uint8_t DMA1_CH1_get_transfer_status(void) {
+	return dma1_ch1_tcif;
+}
+
+/* CONFIGURE DMA1 CHANNEL 2 FOR I2C1 TX TRANSFER.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_CH2_init(void) {
+	// Enable peripheral clock.
+	RCC -> AHBENR |= (0b1 << 0); // DMAEN='1'.
+	// Disable channel before configuration.
+	DMA1 -> CCR2 &= ~(0b1 << 0); // EN='0'.
+	// Memory and peripheral data size are 8 bits (MSIZE='00' and PSIZE='00').
+	DMA1 -> CCR2 &= ~((0b11 << 10) | (0b11 << 8));
+	// Memory increment mode (MINC='1'), peripheral address is fixed (PINC='0').
+	DMA1 -> CCR2 |= (0b1 << 7);
+	DMA1 -> CCR2 &= ~(0b1 << 6);
+	// Read from memory (DIR='1') without circular mode (CIRC='0').
+	DMA1 -> CCR2 |= (0b1 << 4);
+	DMA1 -> CCR2 &= ~(0b1 << 5);
+	// Enable transfer error interrupt (TEIE='1').
+	DMA1 -> CCR2 |= (0b1 << 3);
+	// Peripheral address.
+	DMA1 -> CPAR2 = (uint32_t) &(I2C1 -> TXDR);
+	// Map channel 2 request to I2C1 TX (C2S='0110').
+	DMA1 -> CSELR &= ~(0b1111 << 4);
+	DMA1 -> CSELR |= (0b0110 << 4);
+}
+
+/* START DMA1 CHANNEL 2 TRANSFER.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_CH2_start(void) {
+	// Clear all flags.
+	DMA1 -> IFCR |= (0b1111 << 4); // CGIF2='1', CTCIF2='1', CHTIF2='1' and CTEIF2='1'.
+	// Start transfer.
+	DMA1 -> CCR2 |= (0b1 << 0); // EN='1'.
+}
+
+/* STOP DMA1 CHANNEL 2 TRANSFER.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_CH2_stop(void) {
+	// Stop transfer.
+	DMA1 -> CCR2 &= ~(0b1 << 0); // EN='0'.
+}
+
+/* SET DMA1 CHANNEL 2 SOURCE BUFFER (MUST BE CALLED WHEN THE CHANNEL IS STOPPED).
+ * @param source_buffer_addr:	Address of the buffer to send on I2C1.
+ * @param source_buffer_size:	Number of bytes to transfer.
+ * @return:						None.
+ */
+void DMA1_CH2_set_source_address(uint32_t source_buffer_addr, uint16_t source_buffer_size) {
+	// Set memory address and transfer size.
+	DMA1 -> CMAR2 = source_buffer_addr;
+	DMA1 -> CNDTR2 = source_buffer_size;
+}
+
+/* CONFIGURE DMA1 CHANNEL 3 FOR I2C1 RX TRANSFER.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_CH3_init(void) {
+	// Enable peripheral clock.
+	RCC -> AHBENR |= (0b1 << 0); // DMAEN='1'.
+	// Disable channel before configuration.
+	DMA1 -> CCR3 &= ~(0b1 << 0); // EN='0'.
+	// Memory and peripheral data size are 8 bits (MSIZE='00' and PSIZE='00').
+	DMA1 -> CCR3 &= ~((0b11 << 10) | (0b11 << 8));
+	// Memory increment mode (MINC='1'), peripheral address is fixed (PINC='0').
+	DMA1 -> CCR3 |= (0b1 << 7);
+	DMA1 -> CCR3 &= ~(0b1 << 6);
+	// Read from peripheral (DIR='0') without circular mode (CIRC='0').
+	DMA1 -> CCR3 &= ~((0b1 << 5) | (0b1 << 4));
+	// Enable transfer error interrupt (TEIE='1').
+	DMA1 -> CCR3 |= (0b1 << 3);
+	// Peripheral address.
+	DMA1 -> CPAR3 = (uint32_t) &(I2C1 -> RXDR);
+	// Map channel 3 request to I2C1 RX (C3S='0110').
+	DMA1 -> CSELR &= ~(0b1111 << 8);
+	DMA1 -> CSELR |= (0b0110 << 8);
+}
+
+/* START DMA1 CHANNEL 3 TRANSFER.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_CH3_start(void) {
+	// Clear all flags.
+	DMA1 -> IFCR |= (0b1111 << 8); // CGIF3='1', CTCIF3='1', CHTIF3='1' and CTEIF3='1'.
+	// Start transfer.
+	DMA1 -> CCR3 |= (0b1 << 0); // EN='1'.
+}
+
+/* STOP DMA1 CHANNEL 3 TRANSFER.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_CH3_stop(void) {
+	// Stop transfer.
+	DMA1 -> CCR3 &= ~(0b1 << 0); // EN='0'.
+}
+
+/* SET DMA1 CHANNEL 3 DESTINATION BUFFER (MUST BE CALLED WHEN THE CHANNEL IS STOPPED).
+ * @param destination_buffer_addr:	Address of the buffer that will receive I2C1 bytes.
+ * @param destination_buffer_size:	Number of bytes to transfer.
+ * @return:							None.
+ */
+void DMA1_CH3_set_destination_address(uint32_t destination_buffer_addr, uint16_t destination_buffer_size) {
+	// Set memory address and transfer size.
+	DMA1 -> CMAR3 = destination_buffer_addr;
+	DMA1 -> CNDTR3 = destination_buffer_size;
+}
+
+/* SET THE FUNCTION CALLED UNDER INTERRUPT ON DMA1 CHANNEL 2 OR 3 TRANSFER ERROR.
+ * @param transfer_error_callback:	Function to call.
+ * @param priority:					Interrupt priority (should be the priority of the peripheral using the channels).
+ * @return:							None.
+ */
+void DMA1_CH2_3_set_transfer_error_callback(DMA_transfer_error_cb_t transfer_error_callback, uint8_t priority) {
+	// Register callback.
+	dma1_ch2_3_transfer_error_callback = transfer_error_callback;
+	// Set interrupt priority.
+	NVIC_set_priority(NVIC_INTERRUPT_DMA1_CH_2_3, priority);
+}
+
+/* ENABLE DMA1 CHANNELS 2 AND 3 INTERRUPT.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_CH2_3_enable_interrupt(void) {
+	NVIC_enable_interrupt(NVIC_INTERRUPT_DMA1_CH_2_3);
+}
+
+/* DISABLE DMA1 CHANNELS 2 AND 3 INTERRUPT.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_CH2_3_disable_interrupt(void) {
+	NVIC_disable_interrupt(NVIC_INTERRUPT_DMA1_CH_2_3);
+}
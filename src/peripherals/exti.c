@@ -7,6 +7,7 @@
 
 #include "exti.h"
 
+#include "event.h"
 #include "exti_reg.h"
 #include "gpio.h"
 #include "hmi.h"
@@ -21,10 +22,6 @@
 #define EXTI_RTSR_FTSR_RESERVED_INDEX	18
 #define EXTI_RTSR_FTSR_MAX_INDEX		22
 
-/*** EXTI local global variables ***/
-
-static volatile uint8_t encoder_switch_flag = 0;
-
 /*** EXTI local functions ***/
 
 /* EXTI LINES 0-1 INTERRUPT HANDLER.
@@ -34,9 +31,8 @@ static volatile uint8_t encoder_switch_flag = 0;
 void __attribute__((optimize("-O0"))) EXTI0_1_IRQHandler(void) {
 	// Rotary encoder switch IRQ (PA0).
 	if (((EXTI -> PR) & (0b1 << (GPIO_ENC_SW.pin))) != 0) {
-		// Set flag in HMI driver.
-		HMI_set_irq_flag(HMI_IRQ_ENCODER_SWITCH);
-		encoder_switch_flag = 1;
+		// Post HMI event.
+		EVENT_post(EVENT_TYPE_HMI, HMI_IRQ_ENCODER_SWITCH);
 		// Clear flag.
 		EXTI -> PR |= (0b1 << (GPIO_ENC_SW.pin));
 	}
@@ -51,8 +47,8 @@ void __attribute__((optimize("-O0"))) EXTI2_3_IRQHandler(void) {
 	if (((EXTI -> PR) & (0b1 << (GPIO_ENC_CHA.pin))) != 0) {
 		// Check channel B state.
 		if (GPIO_read(&GPIO_ENC_CHB) == 0) {
-			// Set flag in HMI driver.
-			HMI_set_irq_flag(HMI_IRQ_ENCODER_FORWARD);
+			// Post HMI event.
+			EVENT_post(EVENT_TYPE_HMI, HMI_IRQ_ENCODER_FORWARD);
 		}
 		// Clear flag.
 		EXTI -> PR |= (0b1 << (GPIO_ENC_CHA.pin));
@@ -61,8 +57,8 @@ void __attribute__((optimize("-O0"))) EXTI2_3_IRQHandler(void) {
 	if (((EXTI -> PR) & (0b1 << (GPIO_ENC_CHB.pin))) != 0) {
 		// Check channel A state.
 		if (GPIO_read(&GPIO_ENC_CHA) == 0) {
-			// Set flag in HMI driver.
-			HMI_set_irq_flag(HMI_IRQ_ENCODER_BACKWARD);
+			// Post HMI event.
+			EVENT_post(EVENT_TYPE_HMI, HMI_IRQ_ENCODER_BACKWARD);
 		}
 		// Clear flag.
 		EXTI -> PR |= (0b1 << (GPIO_ENC_CHB.pin));
@@ -76,36 +72,36 @@ void __attribute__((optimize("-O0"))) EXTI2_3_IRQHandler(void) {
 void __attribute__((optimize("-O0"))) EXTI4_15_IRQHandler(void) {
 	// BP1 (PB8).
 	if (((EXTI -> PR) & (0b1 << (GPIO_BP1.pin))) != 0) {
-		// Set flag in HMI driver.
-		HMI_set_irq_flag(HMI_IRQ_BP1);
+		// Post HMI event.
+		EVENT_post(EVENT_TYPE_HMI, HMI_IRQ_BP1);
 		// Clear flag.
 		EXTI -> PR |= (0b1 << (GPIO_BP1.pin));
 	}
 	// BP2 (PB15).
 	if (((EXTI -> PR) & (0b1 << (GPIO_BP2.pin))) != 0) {
-		// Set flag in HMI driver.
-		HMI_set_irq_flag(HMI_IRQ_BP2);
+		// Post HMI event.
+		EVENT_post(EVENT_TYPE_HMI, HMI_IRQ_BP2);
 		// Clear flag.
 		EXTI -> PR |= (0b1 << (GPIO_BP2.pin));
 	}
 	// BP3 (PB9).
 	if (((EXTI -> PR) & (0b1 << (GPIO_BP3.pin))) != 0) {
-		// Set flag in HMI driver.
-		HMI_set_irq_flag(HMI_IRQ_BP3);
+		// Post HMI event.
+		EVENT_post(EVENT_TYPE_HMI, HMI_IRQ_BP3);
 		// Clear flag.
 		EXTI -> PR |= (0b1 << (GPIO_BP3.pin));
 	}
 	// CMD_ON (PB13).
 	if (((EXTI -> PR) & (0b1 << (GPIO_CMD_ON.pin))) != 0) {
-		// Set flag in HMI driver.
-		HMI_set_irq_flag(HMI_IRQ_CMD_ON);
+		// Post HMI event.
+		EVENT_post(EVENT_TYPE_HMI, HMI_IRQ_CMD_ON);
 		// Clear flag.
 		EXTI -> PR |= (0b1 << (GPIO_CMD_ON.pin));
 	}
 	// CMD_OFF (PB14).
 	if (((EXTI -> PR) & (0b1 << (GPIO_CMD_OFF.pin))) != 0) {
-		// Set flag in HMI driver.
-		HMI_set_irq_flag(HMI_IRQ_CMD_OFF);
+		// Post HMI event.
+		EVENT_post(EVENT_TYPE_HMI, HMI_IRQ_CMD_OFF);
 		// Clear flag.
 		EXTI -> PR |= (0b1 << (GPIO_CMD_OFF.pin));
 	}
@@ -203,19 +199,3 @@ void EXTI_clear_all_flags(void) {
 	// Clear all flags.
 	EXTI -> PR |= 0x007BFFFF; // PIFx='1'.
 }
-
-/* READ ENCODER SWITCH FLAG.
- * @param:	None.
- * @return:	None.
- */
-uint8_t EXTI_get_encoder_switch_flag(void) {
-	return encoder_switch_flag;
-}
-
-/* CLEAR ENCODER SWITCH FLAG.
- * @param:	None.
- * @return:	None.
- */
-void EXTI_clear_encoder_switch_flag(void) {
-	encoder_switch_flag = 0;
-}
@@ -7,35 +7,246 @@
 
 #include "i2c.h"
 
+#include "dma.h"
 #include "gpio.h"
 #include "lptim.h"
 #include "mapping.h"
 #include "i2c_reg.h"
+#include "nvic.h"
+#include "pwr.h"
 #include "rcc.h"
 #include "rcc_reg.h"
+#include "syscfg_reg.h"
 #include "types.h"
 
 /*** I2C local macros ***/
 
 #define I2C_ACCESS_TIMEOUT_COUNT	1000000
+#define I2C_QUEUE_DEPTH				4
+
+/*** I2C local structures ***/
+
+typedef struct {
+	uint8_t slave_address;
+	uint8_t* buffer;
+	uint8_t buffer_length;
+	uint8_t read_flag;
+	uint8_t stop_flag;
+	I2C_completion_cb_t completion_callback;
+} I2C_transaction_t;
+
+typedef struct {
+	// Pending transactions (FIFO, the first one is running when busy).
+	I2C_transaction_t queue[I2C_QUEUE_DEPTH];
+	volatile uint8_t queue_read_idx;
+	volatile uint8_t queue_count;
+	volatile uint8_t busy;
+	// Status of the running transaction.
+	volatile I2C_status_t transfer_status;
+	// First error since last wait.
+	volatile I2C_status_t error;
+	I2C_speed_t speed;
+} I2C_context_t;
+
+/*** I2C local global variables ***/
+
+// Note: table is indexed with I2C speed.
+static const uint32_t I2C_TIMINGR[I2C_SPEED_LAST] = {
+	// I2CCLK = PCLK1/(PRESC+1) = SYSCLK/(PRESC+1) = 8MHz (HSI) (PRESC='0001').
+	// SCL frequency to 400kHz. See p.641 of RM0377 datasheet.
+	((1 << 28) | (3 << 20) | (2 << 16) | (3 << 8) | (9 << 0)),
+	// I2CCLK = PCLK1/(PRESC+1) = SYSCLK/(PRESC+1) = 16MHz (HSI) (PRESC='0000').
+	// SCL frequency to 1MHz (fast mode plus).
+	((0 << 28) | (2 << 20) | (0 << 16) | (2 << 8) | (4 << 0))
+};
+static I2C_context_t i2c1_ctx;
 
 /*** I2C local functions ***/
 
-/* CLEAR ALL I2C PERIPHERAL FLAGS
- * @param:			None.
- * @return status:	Function execution status.
+/* RESET I2C PERIPHERAL AND CLEAR ALL FLAGS.
+ * @param:	None.
+ * @return:	None.
  */
-static I2C_status_t _I2C1_clear(void) {
-	// Local variables.
-	I2C_status_t status = I2C_SUCCESS;
-	LPTIM_status_t lptim1_status = LPTIM_SUCCESS;
-	// Disable peripheral.
+static void _I2C1_reset(void) {
+	// Disable peripheral (PE must be kept low during at least 3 APB clock cycles).
 	I2C1 -> CR1 &= ~(0b1 << 0); // PE='0'.
-	lptim1_status = LPTIM1_delay_milliseconds(1, LPTIM_DELAY_MODE_ACTIVE);
-	LPTIM1_status_check(I2C_ERROR_BASE_LPTIM);
+	while (((I2C1 -> CR1) & (0b1 << 0)) != 0);
+	(void) (I2C1 -> CR1);
+	(void) (I2C1 -> CR1);
 	// Enable peripheral and clear all flags.
 	I2C1 -> CR1 |= (0b1 << 0); // PE='1'.
 	I2C1 -> ICR |= 0x00003F38;
+}
+
+/* START FIRST TRANSACTION OF THE QUEUE.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _I2C1_start_transaction(void) {
+	// Local variables.
+	I2C_transaction_t* transaction = &(i2c1_ctx.queue[i2c1_ctx.queue_read_idx]);
+	// Clear all flags.
+	I2C1 -> ICR |= 0x00003F38;
+	i2c1_ctx.transfer_status = I2C_SUCCESS;
+	// Configure DMA channel.
+	if ((transaction -> read_flag) != 0) {
+		DMA1_CH3_set_destination_address((uint32_t) (transaction -> buffer), (transaction -> buffer_length));
+		DMA1_CH3_start();
+		I2C1 -> CR1 |= (0b1 << 15); // RXDMAEN='1'.
+	}
+	else {
+		DMA1_CH2_set_source_address((uint32_t) (transaction -> buffer), (transaction -> buffer_length));
+		DMA1_CH2_start();
+		I2C1 -> CR1 |= (0b1 << 14); // TXDMAEN='1'.
+	}
+	// Transaction end is detected with STOPF when a stop condition is generated, TC otherwise.
+	if (((transaction -> read_flag) != 0) || ((transaction -> stop_flag) != 0)) {
+		I2C1 -> CR1 &= ~(0b1 << 6); // TCIE='0'.
+	}
+	else {
+		I2C1 -> CR1 |= (0b1 << 6); // TCIE='1'.
+	}
+	// Configure number of bytes, direction and 7-bits slave address.
+	I2C1 -> CR2 &= 0xFC000000; // Reset bits 0-25.
+	I2C1 -> CR2 |= ((transaction -> buffer_length) << 16); // NBYTES = buffer_length.
+	if ((transaction -> read_flag) != 0) {
+		I2C1 -> CR2 |= (0b1 << 10); // Read request (RD_WRN='1').
+	}
+	if (((transaction -> read_flag) != 0) || ((transaction -> stop_flag) != 0)) {
+		I2C1 -> CR2 |= (0b1 << 25); // Automatic stop condition after NBYTES (AUTOEND='1').
+	}
+	I2C1 -> CR2 |= (((transaction -> slave_address) & 0x7F) << 1); // SADD = slave_address. Warning: the 7-bits address starts from bit 1!
+	// Generate start condition.
+	I2C1 -> CR2 |= (0b1 << 13); // START='1'.
+}
+
+/* END CURRENT TRANSACTION AND START NEXT ONE.
+ * @param transfer_status:	Status of the current transaction.
+ * @return:					None.
+ */
+static void _I2C1_end_transaction(I2C_status_t transfer_status) {
+	// Local variables.
+	I2C_completion_cb_t completion_callback = i2c1_ctx.queue[i2c1_ctx.queue_read_idx].completion_callback;
+	// Stop DMA requests.
+	I2C1 -> CR1 &= ~((0b1 << 15) | (0b1 << 14) | (0b1 << 6)); // RXDMAEN='0', TXDMAEN='0' and TCIE='0'.
+	DMA1_CH2_stop();
+	DMA1_CH3_stop();
+	// Keep first error.
+	if ((transfer_status != I2C_SUCCESS) && (i2c1_ctx.error == I2C_SUCCESS)) {
+		i2c1_ctx.error = transfer_status;
+	}
+	// Remove transaction from queue.
+	i2c1_ctx.queue_read_idx = (i2c1_ctx.queue_read_idx + 1) % I2C_QUEUE_DEPTH;
+	i2c1_ctx.queue_count--;
+	// Notify owner.
+	if (completion_callback != NULL) {
+		completion_callback(transfer_status);
+	}
+	// Start next transaction.
+	if (i2c1_ctx.queue_count != 0) {
+		_I2C1_start_transaction();
+	}
+	else {
+		i2c1_ctx.busy = 0;
+	}
+}
+
+/* I2C1 INTERRUPT HANDLER.
+ * @param:	None.
+ * @return:	None.
+ */
+void __attribute__((optimize("-O0"))) I2C1_IRQHandler(void) {
+	// Bus error, arbitration lost or timeout (BERR, ARLO or TIMEOUT='1').
+	if (((I2C1 -> ISR) & ((0b1 << 12) | (0b1 << 9) | (0b1 << 8))) != 0) {
+		_I2C1_reset();
+		if (i2c1_ctx.busy != 0) {
+			_I2C1_end_transaction(I2C_ERROR_BUS);
+		}
+		return;
+	}
+	// Not acknowledge received (NACKF='1').
+	if (((I2C1 -> ISR) & (0b1 << 4)) != 0) {
+		// Clear flag.
+		I2C1 -> ICR |= (0b1 << 4); // NACKCF='1'.
+		// Release the bus if the stop condition is not automatic.
+		if (((I2C1 -> CR2) & (0b1 << 25)) == 0) {
+			I2C1 -> CR2 |= (0b1 << 14); // STOP='1'.
+		}
+		// Transaction is ended by the stop condition.
+		i2c1_ctx.transfer_status = I2C_ERROR_NACK;
+	}
+	// Stop condition detected (STOPF='1').
+	if (((I2C1 -> ISR) & (0b1 << 5)) != 0) {
+		// Clear flag.
+		I2C1 -> ICR |= (0b1 << 5); // STOPCF='1'.
+		if (i2c1_ctx.busy != 0) {
+			_I2C1_end_transaction(i2c1_ctx.transfer_status);
+		}
+		return;
+	}
+	// Transfer complete without stop condition (TC='1' and TCIE='1').
+	if ((((I2C1 -> ISR) & (0b1 << 6)) != 0) && (((I2C1 -> CR1) & (0b1 << 6)) != 0)) {
+		if (i2c1_ctx.busy != 0) {
+			_I2C1_end_transaction(I2C_SUCCESS);
+		}
+	}
+}
+
+/* DMA TRANSFER ERROR CALLBACK (CALLED UNDER INTERRUPT WITH THE SAME PRIORITY AS I2C1).
+ * @param:	None.
+ * @return:	None.
+ */
+static void _I2C1_dma_transfer_error_callback(void) {
+	// Abort current transaction.
+	_I2C1_reset();
+	if (i2c1_ctx.busy != 0) {
+		_I2C1_end_transaction(I2C_ERROR_DMA);
+	}
+}
+
+/* ADD A TRANSACTION TO THE QUEUE.
+ * @param transaction:	Transaction to add.
+ * @return status:		Function execution status.
+ */
+static I2C_status_t _I2C1_enqueue(I2C_transaction_t* transaction) {
+	// Local variables.
+	I2C_status_t status = I2C_SUCCESS;
+	uint32_t loop_count = 0;
+	// Check parameters.
+	if ((transaction -> buffer) == NULL) {
+		status = I2C_ERROR_NULL_PARAMETER;
+		goto errors;
+	}
+	// Disable interrupts during queue update.
+	NVIC_disable_interrupt(NVIC_INTERRUPT_I2C1);
+	DMA1_CH2_3_disable_interrupt();
+	if (i2c1_ctx.queue_count >= I2C_QUEUE_DEPTH) {
+		status = I2C_ERROR_QUEUE_FULL;
+		goto enable_irq;
+	}
+	// Check bus when the engine is idle (except if it is still held after a transfer without stop condition).
+	if ((i2c1_ctx.busy == 0) && (((I2C1 -> ISR) & (0b1 << 6)) == 0)) {
+		while (((I2C1 -> ISR) & (0b1 << 15)) != 0) {
+			// Wait for BUSY='0' or timeout.
+			loop_count++;
+			if (loop_count > I2C_ACCESS_TIMEOUT_COUNT) {
+				_I2C1_reset();
+				status = I2C_ERROR_BUSY;
+				goto enable_irq;
+			}
+		}
+	}
+	// Add transaction.
+	i2c1_ctx.queue[(i2c1_ctx.queue_read_idx + i2c1_ctx.queue_count) % I2C_QUEUE_DEPTH] = (*transaction);
+	i2c1_ctx.queue_count++;
+	// Start engine if needed.
+	if (i2c1_ctx.busy == 0) {
+		i2c1_ctx.busy = 1;
+		_I2C1_start_transaction();
+	}
+enable_irq:
+	DMA1_CH2_3_enable_interrupt();
+	NVIC_enable_interrupt(NVIC_INTERRUPT_I2C1);
 errors:
 	return status;
 }
@@ -47,17 +258,65 @@ errors:
  * @return:	None.
  */
 void I2C1_init(void) {
+	// Init context.
+	i2c1_ctx.queue_read_idx = 0;
+	i2c1_ctx.queue_count = 0;
+	i2c1_ctx.busy = 0;
+	i2c1_ctx.transfer_status = I2C_SUCCESS;
+	i2c1_ctx.error = I2C_SUCCESS;
 	// Enable peripheral clock.
 	RCC -> APB1ENR |= (0b1 << 21); // I2C1EN='1'.
 	// Configure power enable pin.
 	GPIO_configure(&GPIO_HMI_POWER_ENABLE, GPIO_MODE_OUTPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
 	I2C1_power_off();
 	// Configure peripheral.
-	// I2CCLK = PCLK1/(PRESC+1) = SYSCLK/(PRESC+1) = 8MHz (HSI) (PRESC='0001').
-	// SCL frequency to 400kHz. See p.641 of RM0377 datasheet.
-	I2C1 -> TIMINGR |= (1 << 28) | (3 << 20)| (2 << 16) | (3 << 8) | (9 << 0);
+	I2C1_set_speed(I2C_SPEED_400KHZ);
+	// Enable stop, not acknowledge and error interrupts (STOPIE='1', NACKIE='1' and ERRIE='1').
+	I2C1 -> CR1 |= (0b1 << 7) | (0b1 << 5) | (0b1 << 4);
+	// Init DMA channels.
+	DMA1_CH2_init();
+	DMA1_CH3_init();
+	// Enable interrupts (same priority so that the handlers never preempt each other).
+	DMA1_CH2_3_set_transfer_error_callback(&_I2C1_dma_transfer_error_callback, 1);
+	DMA1_CH2_3_enable_interrupt();
+	NVIC_set_priority(NVIC_INTERRUPT_I2C1, 1);
+	NVIC_enable_interrupt(NVIC_INTERRUPT_I2C1);
+	// Enable peripheral.
+	I2C1 -> CR1 |= (0b1 << 0); // PE='1'.
+}
+
+/* SET I2C1 BUS SPEED (MUST BE CALLED WHEN NO TRANSACTION IS RUNNING).
+ * @param speed:	Bus speed.
+ * @return status:	Function execution status.
+ */
+I2C_status_t I2C1_set_speed(I2C_speed_t speed) {
+	// Local variables.
+	I2C_status_t status = I2C_SUCCESS;
+	// Check parameter.
+	if (speed >= I2C_SPEED_LAST) {
+		status = I2C_ERROR_SPEED;
+		goto errors;
+	}
+	if (i2c1_ctx.busy != 0) {
+		status = I2C_ERROR_BUSY;
+		goto errors;
+	}
+	// Timings can only be changed when peripheral is disabled.
+	I2C1 -> CR1 &= ~(0b1 << 0); // PE='0'.
+	I2C1 -> TIMINGR = I2C_TIMINGR[speed];
+	// Fast mode plus drive on I2C1 pins.
+	RCC -> APB2ENR |= (0b1 << 0); // SYSCFEN='1'.
+	if (speed == I2C_SPEED_1MHZ) {
+		SYSCFG -> CFGR2 |= (0b1 << 12); // I2C1_FMP='1'.
+	}
+	else {
+		SYSCFG -> CFGR2 &= ~(0b1 << 12); // I2C1_FMP='0'.
+	}
+	i2c1_ctx.speed = speed;
 	// Enable peripheral.
 	I2C1 -> CR1 |= (0b1 << 0); // PE='1'.
+errors:
+	return status;
 }
 
 /* SWITCH ALL I2C1 SLAVES ON.
@@ -92,98 +351,95 @@ void I2C1_power_off(void) {
 	GPIO_configure(&GPIO_I2C1_SDA, GPIO_MODE_OUTPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
 }
 
-/* WRITE DATA ON I2C1 BUS (see algorithme on p.607 of RM0377 datasheet).
- * @param slave_address:	Slave address on 7 bits.
- * @param tx_buf:			Array containing the byte(s) to send.
- * @param tx_buf_length:	Number of bytes to send (length of 'tx_buf').
- * @param stop_flag:		Generate stop condition at the end of the transfer if non zero.
- * @return status:			Function execution status.
+/* QUEUE A WRITE TRANSACTION ON I2C1 BUS (DMA TRANSFER).
+ * @param slave_address:		Slave address on 7 bits.
+ * @param tx_buf:				Array containing the byte(s) to send (must remain valid until transaction completion).
+ * @param tx_buf_length:		Number of bytes to send (length of 'tx_buf').
+ * @param stop_flag:			Generate stop condition at the end of the transfer if non zero.
+ * @param completion_callback:	Function called under interrupt at the end of the transaction (can be NULL).
+ * @return status:				Function execution status.
  */
-I2C_status_t I2C1_write(uint8_t slave_address, uint8_t* tx_buf, uint8_t tx_buf_length, uint8_t stop_flag) {
+I2C_status_t I2C1_write_async(uint8_t slave_address, uint8_t* tx_buf, uint8_t tx_buf_length, uint8_t stop_flag, I2C_completion_cb_t completion_callback) {
+	// Local variables.
+	I2C_transaction_t transaction;
+	// Build transaction.
+	transaction.slave_address = slave_address;
+	transaction.buffer = tx_buf;
+	transaction.buffer_length = tx_buf_length;
+	transaction.read_flag = 0;
+	transaction.stop_flag = stop_flag;
+	transaction.completion_callback = completion_callback;
+	return _I2C1_enqueue(&transaction);
+}
+
+/* QUEUE A READ TRANSACTION ON I2C1 BUS (DMA TRANSFER).
+ * @param slave_address:		Slave address on 7 bits.
+ * @param rx_buf:				Array that will contain the byte(s) to receive (must remain valid until transaction completion).
+ * @param rx_buf_length:		Number of bytes to receive (length of 'rx_buf').
+ * @param completion_callback:	Function called under interrupt at the end of the transaction (can be NULL).
+ * @return status:				Function execution status.
+ */
+I2C_status_t I2C1_read_async(uint8_t slave_address, uint8_t* rx_buf, uint8_t rx_buf_length, I2C_completion_cb_t completion_callback) {
+	// Local variables.
+	I2C_transaction_t transaction;
+	// Build transaction.
+	transaction.slave_address = slave_address;
+	transaction.buffer = rx_buf;
+	transaction.buffer_length = rx_buf_length;
+	transaction.read_flag = 1;
+	transaction.stop_flag = 1;
+	transaction.completion_callback = completion_callback;
+	return _I2C1_enqueue(&transaction);
+}
+
+/* SLEEP UNTIL THE NUMBER OF PENDING TRANSACTIONS IS LOW ENOUGH.
+ * @param pending_max:	Maximum number of transactions still pending when the function returns (0 to wait for all transactions).
+ * @return status:		First error which occured since last call.
+ */
+I2C_status_t I2C1_wait(uint8_t pending_max) {
 	// Local variables.
 	I2C_status_t status = I2C_SUCCESS;
 	uint32_t loop_count = 0;
-	uint8_t idx = 0;
-	// Check parameters.
-	if (tx_buf == NULL) {
-		status = I2C_ERROR_NULL_PARAMETER;
-		goto errors;
-	}
-	// Clear peripheral.
-	_I2C1_clear();
-	// Wait for I2C bus to be ready.
-	while (((I2C1 -> ISR) & (0b1 << 15)) != 0) {
-		// Wait for BUSY='0' or timeout.
-		loop_count++;
-		if (loop_count > I2C_ACCESS_TIMEOUT_COUNT) {
-			status = I2C_ERROR_BUSY;
-			goto errors;
-		}
-	}
-	// Configure number of bytes to send.
-	I2C1 -> CR2 &= 0xFF00FFFF; // Reset bits 16-23.
-	I2C1 -> CR2 |= (tx_buf_length << 16); // NBYTES = tx_buf_length.
-	// Send 7-bits slave address with write request.
-	I2C1 -> CR2 &= ~(0b1 << 10); // Write request (RD_WRN='0').
-	I2C1 -> CR2 &= 0xFFFFFC00; // Reset bits 0-9.
-	I2C1 -> CR2 |= ((slave_address & 0x7F) << 1); // SADD = slave_address. Warning: the 7-bits address starts from bit 1!
-	// Generate start condition.
-	I2C1 -> CR2 |= (0b1 << 13); // START='1'.
-	loop_count = 0;
-	while (((I2C1 -> CR2) & (0b1 << 13)) != 0) {
-		// Wait for START bit to be cleared by hardware or timeout.
-		loop_count++;
-		if (loop_count > I2C_ACCESS_TIMEOUT_COUNT) {
-			status = I2C_ERROR_START_BIT_CLEAR;
-			goto errors;
-		}
-	}
-	// Send bytes.
-	loop_count = 0;
-	while ((idx < tx_buf_length) && (((I2C1 -> ISR) & (0b1 << 4)) == 0)) {
-		// Wait for transmit buffer to be empty (TXIS='1').
-		if (((I2C1 -> ISR) & (0b1 << 1)) != 0) {
-			// Send next byte.
-			I2C1 -> TXDR = tx_buf[idx];
-			idx++;
-		}
-		// Exit if timeout.
+	// Sleep until transfers are complete.
+	while (i2c1_ctx.queue_count > pending_max) {
+		PWR_enter_sleep_mode();
 		loop_count++;
 		if (loop_count > I2C_ACCESS_TIMEOUT_COUNT) {
-			status = I2C_ERROR_TX_BUFFER_EMPTY;
+			status = I2C_ERROR_TIMEOUT;
 			goto errors;
 		}
 	}
-	// Wait for last byte to be sent.
-	loop_count = 0;
-	while (((I2C1 -> ISR) & (0b1 << 6)) == 0) {
-		// Wait for TC='1' or timeout.
-		loop_count++;
-		if (loop_count > I2C_ACCESS_TIMEOUT_COUNT) {
-			status = I2C_ERROR_TRANSFER_COMPLETE;
-			goto errors;
-		}
-	}
-	if (stop_flag != 0) {
-		// Generate stop condition.
-		I2C1 -> CR2 |= (0b1 << 14);
-		loop_count = 0;
-		while (((I2C1 -> ISR) & (0b1 << 5)) == 0) {
-			// Wait for STOPF='1' or timeout.
-			loop_count++;
-			if (loop_count > I2C_ACCESS_TIMEOUT_COUNT) {
-				status = I2C_ERROR_STOP_DETECTION_FLAG;
-				goto errors;
-			}
-		}
-		// Clear flag.
-		I2C1 -> ICR |= (0b1 << 5); // STOPCF='1'.
-	}
+	// Read and clear error.
+	NVIC_disable_interrupt(NVIC_INTERRUPT_I2C1);
+	DMA1_CH2_3_disable_interrupt();
+	status = i2c1_ctx.error;
+	i2c1_ctx.error = I2C_SUCCESS;
+	DMA1_CH2_3_enable_interrupt();
+	NVIC_enable_interrupt(NVIC_INTERRUPT_I2C1);
 errors:
 	return status;
 }
 
-/* READ BYTES FROM I2C1 BUS (see algorithme on p.611 of RM0377 datasheet).
+/* WRITE DATA ON I2C1 BUS AND WAIT FOR COMPLETION.
+ * @param slave_address:	Slave address on 7 bits.
+ * @param tx_buf:			Array containing the byte(s) to send.
+ * @param tx_buf_length:	Number of bytes to send (length of 'tx_buf').
+ * @param stop_flag:		Generate stop condition at the end of the transfer if non zero.
+ * @return status:			Function execution status.
+ */
+I2C_status_t I2C1_write(uint8_t slave_address, uint8_t* tx_buf, uint8_t tx_buf_length, uint8_t stop_flag) {
+	// Local variables.
+	I2C_status_t status = I2C_SUCCESS;
+	// Queue transaction.
+	status = I2C1_write_async(slave_address, tx_buf, tx_buf_length, stop_flag, NULL);
+	if (status != I2C_SUCCESS) goto errors;
+	// Wait for completion.
+	status = I2C1_wait(0);
+errors:
+	return status;
+}
+
+/* READ BYTES FROM I2C1 BUS AND WAIT FOR COMPLETION.
  * @param slave_address:	Slave address on 7 bits.
  * @param rx_buf:			Array that will contain the byte(s) to receive.
  * @param rx_buf_length:	Number of bytes to receive (length of 'rx_buf').
@@ -192,73 +448,11 @@ errors:
 I2C_status_t I2C1_read(uint8_t slave_address, uint8_t* rx_buf, uint8_t rx_buf_length) {
 	// Local variables.
 	I2C_status_t status = I2C_SUCCESS;
-	uint32_t loop_count = 0;
-	uint8_t idx = 0;
-	// Check parameters.
-	if (rx_buf == NULL) {
-		status = I2C_ERROR_NULL_PARAMETER;
-		goto errors;
-	}
-	// Clear peripheral.
-	_I2C1_clear();
-	// Wait for I2C bus to be ready.
-	while (((I2C1 -> ISR) & (0b1 << 15)) != 0) {
-		// Wait for BUSY='0' or timeout.
-		loop_count++;
-		if (loop_count > I2C_ACCESS_TIMEOUT_COUNT) {
-			status = I2C_ERROR_BUSY;
-			goto errors;
-		}
-	}
-	// Configure number of bytes to send.
-	I2C1 -> CR2 &= 0xFF00FFFF; // Reset bits 16-23.
-	I2C1 -> CR2 |= (rx_buf_length << 16); // NBYTES = rx_buf_length.
-	// Send 7-bits slave address with write request.
-	I2C1 -> CR2 |= (0b1 << 10); // Read request (RD_WRN='1').
-	I2C1 -> CR2 |= (0b1 << 12); // 7-bits mode.
-	I2C1 -> CR2 &= 0xFFFFFC00; // Reset bits 0-9.
-	I2C1 -> CR2 |= ((slave_address & 0x7F) << 1); // SADD = slave_address. Warning: the 7-bits address starts from bit 1!
-	// Generate start condition.
-	I2C1 -> CR2 |= (0b1 << 13); // START='1'.
-	loop_count = 0;
-	while (((I2C1 -> CR2) & (0b1 << 13)) != 0) {
-		// Wait for START bit to be cleared by hardware or timeout.
-		loop_count++;
-		if (loop_count > I2C_ACCESS_TIMEOUT_COUNT) {
-			status = I2C_ERROR_START_BIT_CLEAR;
-			goto errors;
-		}
-	}
-	// Get bytes.
-	loop_count = 0;
-	while (idx < rx_buf_length) {
-		// Wait for incoming data (RXNE='1').
-		if (((I2C1 -> ISR) & (0b1 << 2)) != 0) {
-			// Fill RX buffer with new byte */
-			rx_buf[idx] = (I2C1 -> RXDR);
-			idx++;
-		}
-		// Exit if timeout.
-		loop_count++;
-		if (loop_count > I2C_ACCESS_TIMEOUT_COUNT) {
-			status = I2C_ERROR_RX_TIMEOUT;
-			goto errors;
-		}
-	}
-	// Send a NACK and STOP condition after last byte.
-	I2C1 -> CR2 |= (0b1 << 15);
-	I2C1 -> CR2 |= (0b1 << 14);
-	loop_count = 0;
-	while (((I2C1 -> ISR) & (0b1 << 5)) == 0) {
-		// Wait for STOPF='1' or timeout.
-		loop_count++;
-		if (loop_count > I2C_ACCESS_TIMEOUT_COUNT) {
-			status = I2C_ERROR_STOP_DETECTION_FLAG;
-			goto errors;
-		}
-	}
-	// Clear flag.
-	I2C1 -> ICR |= (0b1 << 5); // STOPCF='1'.
+	// Queue transaction.
+	status = I2C1_read_async(slave_address, rx_buf, rx_buf_length, NULL);
+	if (status != I2C_SUCCESS) goto errors;
+	// Wait for completion.
+	status = I2C1_wait(0);
 errors:
 	return status;
 }
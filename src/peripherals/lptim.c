@@ -7,13 +7,14 @@
 
 #include "lptim.h"
 
+#include "event.h"
 #include "exti.h"
 #include "iwdg.h"
 #include "lptim_reg.h"
 #include "nvic.h"
-#include "pwr.h"
 #include "rcc.h"
 #include "rcc_reg.h"
+#include "scheduler.h"
 #include "types.h"
 
 /*** LPTIM local macros ***/
@@ -25,7 +26,7 @@
 /*** LPTIM local global variables ***/
 
 static uint32_t lptim_clock_frequency_hz = 0;
-static volatile uint8_t lptim_wake_up = 0;
+static volatile uint8_t lptim_wake_up = 0; // Set in interrupt so that polled waits do not depend on the event dispatcher.
 
 /*** LPTIM local functions ***/
 
@@ -36,9 +37,10 @@ static volatile uint8_t lptim_wake_up = 0;
 void __attribute__((optimize("-O0"))) LPTIM1_IRQHandler(void) {
 	// Check flag.
 	if (((LPTIM1 -> ISR) & (0b1 << 1)) != 0) {
-		// Set local flag.
+		// Set local flag and notify main context.
 		if (((LPTIM1 -> IER) & (0b1 << 1)) != 0) {
 			lptim_wake_up = 1;
+			EVENT_post(EVENT_TYPE_LPTIM1_WAKE_UP, 0);
 		}
 		// Clear flag.
 		LPTIM1 -> ICR |= (0b1 << 1);
@@ -141,14 +143,16 @@ LPTIM_status_t LPTIM1_delay_milliseconds(uint32_t delay_ms, LPTIM_delay_mode_t d
 		LPTIM1 -> ICR |= (0b1 << 1);
 		break;
 	case LPTIM_DELAY_MODE_STOP:
+		// Drain pending events before arming the timer.
+		EVENT_dispatch();
 		// Enable interrupt.
 		NVIC_enable_interrupt(NVIC_INTERRUPT_LPTIM1);
 		lptim_wake_up = 0;
 		// Start timer.
 		LPTIM1 -> CR |= (0b1 << 1); // SNGSTRT='1'.
-		// Wait for interrupt.
+		// Wait for wake-up event.
 		while (lptim_wake_up == 0) {
-			PWR_enter_stop_mode();
+			SCHEDULER_yield();
 		}
 		NVIC_disable_interrupt(NVIC_INTERRUPT_LPTIM1);
 		break;
@@ -217,3 +221,20 @@ void LPTIM1_stop(void) {
 uint8_t LPTIM1_get_wake_up_flag(void) {
 	return lptim_wake_up;
 }
+
+/* READ TIME ELAPSED SINCE LAST LPTIM START.
+ * @param:				None.
+ * @return elapsed_ms:	Number of milliseconds elapsed since the timer was started.
+ */
+uint32_t LPTIM1_get_elapsed_milliseconds(void) {
+	// Local variables.
+	uint32_t cnt = 0;
+	// Check clock frequency.
+	if (lptim_clock_frequency_hz == 0) return 0;
+	// Read counter until two consecutive values are equal (asynchronous clock).
+	do {
+		cnt = ((LPTIM1 -> CNT) & 0x0000FFFF);
+	}
+	while (cnt != ((LPTIM1 -> CNT) & 0x0000FFFF));
+	return ((cnt * 1000) / (lptim_clock_frequency_hz));
+}
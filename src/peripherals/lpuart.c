@@ -14,6 +14,7 @@
 #include "lpuart_reg.h"
 #include "mapping.h"
 #include "nvic.h"
+#include "pwr.h"
 #include "rcc.h"
 #include "rcc_reg.h"
 
@@ -22,12 +23,25 @@
 #define LPUART_BAUD_RATE_DEFAULT 	1200
 #define LPUART_BRR_VALUE_MIN_LSE	0x0300
 
-#define LPUART_TIMEOUT_COUNT		100000
+#define LPUART_TX_TIMEOUT_MARGIN_MS	100
 //#define LPUART_USE_NRE
 
+/*** LPUART local structures ***/
+
+typedef struct {
+	uint32_t baud_rate;
+	LPUART_rx_callback_t rx_callback;
+	LPUART_tx_callback_t tx_callback;
+	// Transmission.
+	uint8_t* tx_data;
+	uint8_t tx_size;
+	volatile uint8_t tx_idx;
+	volatile uint8_t tx_done;
+} LPUART_context_t;
+
 /*** LPUART local global variables ***/
 
-static LPUART_rx_callback_t LPUART1_rx_callback;
+static LPUART_context_t lpuart1_ctx;
 
 /*** LPUART local functions ***/
 
@@ -42,12 +56,37 @@ void LPUART1_IRQHandler(void) {
 	if (((LPUART1 -> ISR) & (0b1 << 5)) != 0) {
 		// Read incoming byte.
 		rx_byte = (LPUART1 -> RDR);
-		if (LPUART1_rx_callback != NULL) {
-			LPUART1_rx_callback(rx_byte);
+		if (lpuart1_ctx.rx_callback != NULL) {
+			lpuart1_ctx.rx_callback(rx_byte);
 		}
 		// Clear RXNE flag.
 		LPUART1 -> RQR |= (0b1 << 3);
 	}
+	// TXE interrupt.
+	if ((((LPUART1 -> ISR) & (0b1 << 7)) != 0) && (((LPUART1 -> CR1) & (0b1 << 7)) != 0)) {
+		// Check index.
+		if (lpuart1_ctx.tx_idx < lpuart1_ctx.tx_size) {
+			// Fill transmit register with next byte.
+			LPUART1 -> TDR = lpuart1_ctx.tx_data[lpuart1_ctx.tx_idx];
+			lpuart1_ctx.tx_idx++;
+		}
+		else {
+			// Last byte is being sent, wait for end of transmission.
+			LPUART1 -> CR1 &= ~(0b1 << 7); // TXEIE='0'.
+			LPUART1 -> CR1 |= (0b1 << 6); // TCIE='1'.
+		}
+	}
+	// TC interrupt.
+	if ((((LPUART1 -> ISR) & (0b1 << 6)) != 0) && (((LPUART1 -> CR1) & (0b1 << 6)) != 0)) {
+		// Disable interrupt and clear flag.
+		LPUART1 -> CR1 &= ~(0b1 << 6); // TCIE='0'.
+		LPUART1 -> ICR |= (0b1 << 6); // TCCF='1'.
+		// Frame completed.
+		lpuart1_ctx.tx_done = 1;
+		if (lpuart1_ctx.tx_callback != NULL) {
+			lpuart1_ctx.tx_callback();
+		}
+	}
 	// Overrun error interrupt.
 	if (((LPUART1 -> ISR) & (0b1 << 3)) != 0) {
 		// Clear ORE flag.
@@ -56,29 +95,6 @@ void LPUART1_IRQHandler(void) {
 	EXTI_clear_flag(EXTI_LINE_LPUART1);
 }
 
-/* FILL LPUART1 TX BUFFER WITH A NEW BYTE.
- * @param tx_byte:	Byte to append.
- * @return status:	Function execution status.
- */
-static LPUART_status_t _LPUART1_fill_tx_buffer(uint8_t tx_byte) {
-	// Local variables.
-	LPUART_status_t status = LPUART_SUCCESS;
-	uint32_t loop_count = 0;
-	// Fill transmit register.
-	LPUART1 -> TDR = tx_byte;
-	// Wait for transmission to complete.
-	while (((LPUART1 -> ISR) & (0b1 << 7)) == 0) {
-		// Wait for TXE='1' or timeout.
-		loop_count++;
-		if (loop_count > LPUART_TIMEOUT_COUNT) {
-			status = LPUART_ERROR_TX_TIMEOUT;
-			goto errors;
-		}
-	}
-errors:
-	return status;
-}
-
 /* FILL LPUART1 TX BUFFER WITH A NEW BYTE.
  * @param tx_byte:	Byte to append.
  * @return status:	Function execution status.
@@ -96,6 +112,8 @@ static LPUART_status_t _LPUART1_set_baud_rate(uint32_t baud_rate) {
 		goto errors;
 	}
 	LPUART1 -> BRR = (brr & 0x000FFFFF); // BRR = (256*fCK)/(baud rate). See p.730 of RM0377 datasheet.
+	// Store baud rate to compute transmission timeout.
+	lpuart1_ctx.baud_rate = baud_rate;
 errors:
 	return status;
 }
@@ -107,6 +125,14 @@ errors:
  * @return:	None.
  */
 void LPUART1_init(void) {
+	// Init context.
+	lpuart1_ctx.baud_rate = LPUART_BAUD_RATE_DEFAULT;
+	lpuart1_ctx.rx_callback = NULL;
+	lpuart1_ctx.tx_callback = NULL;
+	lpuart1_ctx.tx_data = NULL;
+	lpuart1_ctx.tx_size = 0;
+	lpuart1_ctx.tx_idx = 0;
+	lpuart1_ctx.tx_done = 0;
 	// Select LSE as clock source.
 	RCC -> CCIPR |= (0b11 << 10); // LPUART1SEL='11'.
 	// Enable peripheral clock.
@@ -235,8 +261,9 @@ LPUART_status_t LPUART1_configure(LPUART_config_t* config) {
 		status = LPUART_ERROR_RX_MODE;
 		goto errors;
 	}
-	// Store callback (even if NULL).
-	LPUART1_rx_callback = (config -> rx_callback);
+	// Store callbacks (even if NULL).
+	lpuart1_ctx.rx_callback = (config -> rx_callback);
+	lpuart1_ctx.tx_callback = (config -> tx_callback);
 errors:
 	// Enable peripheral.
 	LPUART1 -> CR1 |= (0b1 << 0); // UE='1'.
@@ -251,28 +278,44 @@ errors:
 LPUART_status_t LPUART1_send(uint8_t* data, uint8_t data_size_bytes) {
 	// Local variables.
 	LPUART_status_t status = LPUART_SUCCESS;
-	uint8_t idx = 0;
-	uint32_t loop_count = 0;
+	LPTIM_status_t lptim1_status = LPTIM_SUCCESS;
+	uint32_t tx_timeout_ms = 0;
 	// Check parameters.
 	if (data == NULL) {
 		status = LPUART_ERROR_NULL_PARAMETER;
 		goto errors;
 	}
-	// Bytes loop.
-	for (idx=0 ; idx<data_size_bytes ; idx++) {
-		// Fill buffer.
-		status = _LPUART1_fill_tx_buffer(data[idx]);
-		if (status != LPUART_SUCCESS) goto errors;
+	if (data_size_bytes == 0) goto errors;
+	// Init transfer.
+	lpuart1_ctx.tx_data = data;
+	lpuart1_ctx.tx_size = data_size_bytes;
+	lpuart1_ctx.tx_idx = 0;
+	lpuart1_ctx.tx_done = 0;
+	// Start timeout timer (10 bits per byte).
+	tx_timeout_ms = ((((uint32_t) data_size_bytes) * 10 * 1000) / (lpuart1_ctx.baud_rate)) + LPUART_TX_TIMEOUT_MARGIN_MS;
+	lptim1_status = LPTIM1_start(tx_timeout_ms);
+	LPTIM1_status_check(LPUART_ERROR_BASE_LPTIM);
+	// Clear flag and enable interrupt.
+	LPUART1 -> ICR |= (0b1 << 6); // TCCF='1'.
+	NVIC_enable_interrupt(NVIC_INTERRUPT_LPUART1);
+	// Start transmission.
+	LPUART1 -> CR1 |= (0b1 << 7); // TXEIE='1'.
+	// Bytes are sent under interrupt while the core sleeps.
+	// Note: stop mode can not be used since TXE and TC events do not wake-up the MCU.
+	while ((lpuart1_ctx.tx_done == 0) && (LPTIM1_get_wake_up_flag() == 0)) {
+		PWR_enter_sleep_mode();
 	}
-	// Wait for TC flag.
-	while (((LPUART1 -> ISR) & (0b1 << 6)) == 0) {
-		// Exit if timeout.
-		loop_count++;
-		if (loop_count > LPUART_TIMEOUT_COUNT) {
-			status = LPUART_ERROR_TC_TIMEOUT;
-			goto errors;
-		}
+	// Check transmission status.
+	if (lpuart1_ctx.tx_done == 0) {
+		status = (lpuart1_ctx.tx_idx < lpuart1_ctx.tx_size) ? LPUART_ERROR_TX_TIMEOUT : LPUART_ERROR_TC_TIMEOUT;
 	}
 errors:
+	// Disable transmission interrupts.
+	LPUART1 -> CR1 &= ~(0b11 << 6); // TXEIE='0' and TCIE='0'.
+	LPTIM1_stop();
+	// Keep interrupt enabled only if receiver is on.
+	if (((LPUART1 -> CR1) & (0b1 << 2)) == 0) {
+		NVIC_disable_interrupt(NVIC_INTERRUPT_LPUART1);
+	}
 	return status;
 }
@@ -14,6 +14,7 @@
 #include "rcc_reg.h"
 #include "rtc_reg.h"
 #include "scb_reg.h"
+#include "types.h"
 
 /*** PWR functions ***/
 
@@ -51,10 +52,10 @@ void PWR_enter_sleep_mode(void) {
 }
 
 /* FUNCTION TO ENTER STOP MODE.
- * @param:	None.
- * @return:	None.
+ * @param abort_callback:	Function called with interrupts masked just before entering stop mode, stop mode is skipped if it returns non-zero (can be NULL).
+ * @return:					None.
  */
-void PWR_enter_stop_mode(void) {
+void PWR_enter_stop_mode(PWR_abort_cb_t abort_callback) {
 	// Regulator in low power mode.
 	PWR -> CR |= (0b1 << 0); // LPSDSR='1'.
 	// Clear WUF flag.
@@ -66,9 +67,15 @@ void PWR_enter_stop_mode(void) {
 	EXTI -> PR |= 0x007BFFFF; // PIFx='1'.
 	RTC -> ISR &= 0xFFFF005F; // Reset alarms, wake-up, tamper and timestamp flags.
 	NVIC -> ICPR = 0xFFFFFFFF; // CLEARPENDx='1'.
-	// Enter stop mode.
-	SCB -> SCR |= (0b1 << 2); // SLEEPDEEP='1'.
-	__asm volatile ("wfi"); // Wait For Interrupt core instruction.
+	// Mask interrupts: an interrupt occurring after the abort check stays pending and wakes the core up immediately.
+	__asm volatile ("cpsid i" : : : "memory");
+	if ((abort_callback == NULL) || (abort_callback() == 0)) {
+		// Enter stop mode.
+		SCB -> SCR |= (0b1 << 2); // SLEEPDEEP='1'.
+		__asm volatile ("wfi"); // Wait For Interrupt core instruction.
+	}
+	// Unmask interrupts (pending interrupts are serviced here).
+	__asm volatile ("cpsie i" : : : "memory");
 }
 
 /* FUNCTION TO FORCE A SOFTWARE RESET.
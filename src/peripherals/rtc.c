@@ -7,6 +7,7 @@
 
 #include "rtc.h"
 
+#include "event.h"
 #include "exti.h"
 #include "nvic.h"
 #include "rcc_reg.h"
@@ -17,9 +18,6 @@
 
 #define RTC_INIT_TIMEOUT_COUNT		1000
 #define RTC_WAKEUP_TIMER_DELAY_MAX	65536
-// RTC wake-up timer period.
-// Warning: this value must be lower than the watchdog period = 25s.
-#define RTC_WAKEUP_PERIOD_SECONDS	10
 
 /*** RTC local global variables ***/
 
@@ -34,9 +32,10 @@ static volatile uint32_t rtc_time_seconds = 0;
 void __attribute__((optimize("-O0"))) RTC_IRQHandler(void) {
 	// Wake-up timer interrupt.
 	if (((RTC -> ISR) & (0b1 << 10)) != 0) {
-		// Set local flag.
+		// Update uptime and notify main context.
 		if (((RTC -> CR) & (0b1 << 14)) != 0) {
 			rtc_time_seconds += RTC_WAKEUP_PERIOD_SECONDS;
+			EVENT_post(EVENT_TYPE_RTC_WAKE_UP, 0);
 		}
 		// Clear flags.
 		RTC -> ISR &= ~(0b1 << 10); // WUTF='0'.
@@ -213,3 +212,27 @@ errors:
 uint32_t RTC_get_time_seconds(void) {
 	return rtc_time_seconds;
 }
+
+/* READ CURRENT TIME OF DAY WITH SUB-SECOND RESOLUTION.
+ * @param:					None.
+ * @return time_of_day_ms:	Number of milliseconds elapsed since the last calendar day change (wraps after RTC_TIME_OF_DAY_MS_MAX).
+ */
+uint32_t RTC_get_time_of_day_milliseconds(void) {
+	// Local variables.
+	uint32_t tr = 0;
+	uint32_t ssr = 0;
+	uint32_t prediv_s = ((RTC -> PRER) & 0x00007FFF);
+	uint32_t time_of_day_seconds = 0;
+	// Read registers until two consecutive values are equal (shadow registers are bypassed).
+	do {
+		ssr = ((RTC -> SSR) & 0x0000FFFF);
+		tr = (RTC -> TR);
+	}
+	while ((ssr != ((RTC -> SSR) & 0x0000FFFF)) || (tr != (RTC -> TR)));
+	// Convert BCD calendar time.
+	time_of_day_seconds += ((((tr >> 20) & 0x3) * 10) + ((tr >> 16) & 0xF)) * 3600; // Hours.
+	time_of_day_seconds += ((((tr >> 12) & 0x7) * 10) + ((tr >> 8) & 0xF)) * 60; // Minutes.
+	time_of_day_seconds += ((((tr >> 4) & 0x7) * 10) + ((tr >> 0) & 0xF)); // Seconds.
+	// Add sub-seconds (down counter from PREDIV_S).
+	return ((time_of_day_seconds * 1000) + (((prediv_s - ssr) * 1000) / (prediv_s + 1)));
+}
@@ -0,0 +1,151 @@
+/*
+ * event.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "event.h"
+
+#include "rtc.h"
+#include "types.h"
+
+/*** EVENT local macros ***/
+
+#define EVENT_POOL_SIZE		20
+
+// Each event type has its own ring, written by a single interrupt (or several interrupts sharing the same priority) and read by the dispatcher only.
+// Ring indexes are free running 8-bits counters, so sizes must be powers of 2 and every slot is usable.
+// Note: tables are indexed with EVENT_type_t.
+static const uint8_t EVENT_QUEUE_OFFSET[EVENT_TYPE_LAST] = {0, 8, 10, 12};
+static const uint8_t EVENT_QUEUE_SIZE[EVENT_TYPE_LAST] = {8, 2, 2, 8};
+
+/*** EVENT local structures ***/
+
+typedef struct {
+	volatile uint8_t write_count; // Only written by the producer.
+	volatile uint8_t read_count; // Only written by the dispatcher.
+	volatile uint32_t overflow_count; // Only written by the producer.
+} EVENT_queue_t;
+
+typedef struct {
+	volatile EVENT_t pool[EVENT_POOL_SIZE];
+	EVENT_queue_t queue[EVENT_TYPE_LAST];
+	EVENT_callback_t callback[EVENT_TYPE_LAST];
+} EVENT_context_t;
+
+/*** EVENT local global variables ***/
+
+static EVENT_context_t event_ctx;
+
+/*** EVENT functions ***/
+
+/* INIT EVENT QUEUES.
+ * @param:	None.
+ * @return:	None.
+ */
+void EVENT_init(void) {
+	// Local variables.
+	uint8_t idx = 0;
+	// Reset queues and callbacks.
+	for (idx=0 ; idx<EVENT_TYPE_LAST ; idx++) {
+		event_ctx.queue[idx].write_count = 0;
+		event_ctx.queue[idx].read_count = 0;
+		event_ctx.queue[idx].overflow_count = 0;
+		event_ctx.callback[idx] = NULL;
+	}
+}
+
+/* REGISTER THE FUNCTION CALLED BY THE DISPATCHER FOR AN EVENT TYPE.
+ * @param type:		Event type.
+ * @param callback:	Function to call (must not call EVENT_dispatch).
+ * @return:			None.
+ */
+void EVENT_set_callback(EVENT_type_t type, EVENT_callback_t callback) {
+	// Check parameter.
+	if (type >= EVENT_TYPE_LAST) return;
+	event_ctx.callback[type] = callback;
+}
+
+/* POST AN EVENT (CALLED BY INTERRUPTS).
+ * @param type:	Event type.
+ * @param data:	Event data.
+ * @return:		None.
+ */
+void EVENT_post(EVENT_type_t type, uint8_t data) {
+	// Local variables.
+	uint8_t write_count = 0;
+	uint8_t slot_idx = 0;
+	// Check parameter.
+	if (type >= EVENT_TYPE_LAST) return;
+	write_count = event_ctx.queue[type].write_count;
+	// Drop event if queue is full.
+	if (((uint8_t) (write_count - event_ctx.queue[type].read_count)) >= EVENT_QUEUE_SIZE[type]) {
+		event_ctx.queue[type].overflow_count++;
+		return;
+	}
+	// Fill slot before publishing it.
+	slot_idx = EVENT_QUEUE_OFFSET[type] + (write_count & (EVENT_QUEUE_SIZE[type] - 1));
+	event_ctx.pool[slot_idx].type = type;
+	event_ctx.pool[slot_idx].data = data;
+	event_ctx.pool[slot_idx].timestamp_ms = RTC_get_time_of_day_milliseconds();
+	event_ctx.queue[type].write_count = (uint8_t) (write_count + 1);
+}
+
+/* CALL THE REGISTERED CALLBACK OF ALL PENDING EVENTS (CALLED IN MAIN CONTEXT ONLY).
+ * @param:	None.
+ * @return:	None.
+ */
+void EVENT_dispatch(void) {
+	// Local variables.
+	EVENT_t event;
+	uint8_t type = 0;
+	uint8_t read_count = 0;
+	uint8_t slot_idx = 0;
+	// Drain all queues.
+	for (type=0 ; type<EVENT_TYPE_LAST ; type++) {
+		read_count = event_ctx.queue[type].read_count;
+		while (read_count != event_ctx.queue[type].write_count) {
+			// Copy event before releasing the slot.
+			slot_idx = EVENT_QUEUE_OFFSET[type] + (read_count & (EVENT_QUEUE_SIZE[type] - 1));
+			event.type = event_ctx.pool[slot_idx].type;
+			event.data = event_ctx.pool[slot_idx].data;
+			event.timestamp_ms = event_ctx.pool[slot_idx].timestamp_ms;
+			read_count++;
+			event_ctx.queue[type].read_count = read_count;
+			// Execute callback.
+			if (event_ctx.callback[type] != NULL) {
+				event_ctx.callback[type](&event);
+			}
+		}
+	}
+}
+
+/* CHECK IF AT LEAST ONE EVENT IS WAITING FOR DISPATCH.
+ * @param:	None.
+ * @return:	1 if an event is pending, 0 otherwise.
+ */
+uint8_t EVENT_is_pending(void) {
+	// Local variables.
+	uint8_t type = 0;
+	// Check all queues.
+	for (type=0 ; type<EVENT_TYPE_LAST ; type++) {
+		if (event_ctx.queue[type].read_count != event_ctx.queue[type].write_count) return 1;
+	}
+	return 0;
+}
+
+/* GET THE TOTAL NUMBER OF EVENTS DROPPED BECAUSE OF A FULL QUEUE.
+ * @param:					None.
+ * @return overflow_count:	Number of lost events since initialization.
+ */
+uint32_t EVENT_get_overflow_count(void) {
+	// Local variables.
+	uint32_t overflow_count = 0;
+	uint8_t type = 0;
+	// Sum all queues.
+	for (type=0 ; type<EVENT_TYPE_LAST ; type++) {
+		overflow_count += event_ctx.queue[type].overflow_count;
+	}
+	return overflow_count;
+}
@@ -11,7 +11,16 @@
 /*** MATH local macros ***/
 
 #define MATH_MEDIAN_FILTER_LENGTH_MAX	0xFF
+#define MATH_SORTING_NETWORK_LENGTH_MAX	9
 static const uint32_t MATH_POW10[MATH_DECIMAL_MAX_LENGTH] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+// Optimal sorting networks (comparator pairs) for the most common median filter lengths.
+static const uint8_t MATH_SORTING_NETWORK_3[][2] = {{0,2}, {0,1}, {1,2}};
+static const uint8_t MATH_SORTING_NETWORK_5[][2] = {{0,1}, {3,4}, {2,4}, {2,3}, {0,3}, {0,2}, {1,4}, {1,3}, {1,2}};
+static const uint8_t MATH_SORTING_NETWORK_7[][2] = {{0,6}, {2,3}, {4,5}, {0,2}, {1,4}, {3,6}, {0,1}, {2,5}, {3,4}, {1,2}, {4,6}, {2,3}, {4,5}, {1,2}, {3,4}, {5,6}};
+static const uint8_t MATH_SORTING_NETWORK_9[][2] = {{0,3}, {1,7}, {2,5}, {4,8}, {0,7}, {2,4}, {3,8}, {5,6}, {0,2}, {1,3}, {4,5}, {7,8}, {1,4}, {3,6}, {5,7}, {0,1}, {2,4}, {3,5}, {6,8}, {2,3}, {4,5}, {6,7}, {1,2}, {3,4}, {5,6}};
+// Note: tables are indexed with buffer length.
+static const uint8_t (*const MATH_SORTING_NETWORK[MATH_SORTING_NETWORK_LENGTH_MAX + 1])[2] = {NULL, NULL, NULL, MATH_SORTING_NETWORK_3, NULL, MATH_SORTING_NETWORK_5, NULL, MATH_SORTING_NETWORK_7, NULL, MATH_SORTING_NETWORK_9};
+static const uint8_t MATH_SORTING_NETWORK_SIZE[MATH_SORTING_NETWORK_LENGTH_MAX + 1] = {0, 0, 0, 3, 0, 9, 0, 16, 0, 25};
 
 /*** MATH local functions ***/
 
@@ -55,6 +64,51 @@ static const uint32_t MATH_POW10[MATH_DECIMAL_MAX_LENGTH] = {1, 10, 100, 1000, 1
 	} \
 }
 
+/* GENERIC FUNCTION TO SORT TWO ELEMENTS OF THE LOCAL BUFFER.
+ * @param idx1:	Index of the element which must be the lowest.
+ * @param idx2:	Index of the element which must be the highest.
+ * @return:		None.
+ */
+#define _MATH_compare_exchange(idx1, idx2) { \
+	if (local_buf[idx1] > local_buf[idx2]) { \
+		temp = local_buf[idx1]; \
+		local_buf[idx1] = local_buf[idx2]; \
+		local_buf[idx2] = temp; \
+	} \
+}
+
+/* GENERIC FUNCTION TO PUT THE K-TH SMALLEST ELEMENT OF THE LOCAL BUFFER AT INDEX K (WIRTH SELECTION).
+ * @param k:			Index to select.
+ * @param first_idx:	First index of the search range (all previous elements must be lower or equal).
+ * @param last_idx:		Last index of the search range.
+ * @return:				None.
+ */
+#define _MATH_select(k, first_idx, last_idx) { \
+	int16_t left = first_idx; \
+	int16_t right = last_idx; \
+	int16_t i = 0; \
+	int16_t j = 0; \
+	while (left < right) { \
+		pivot = local_buf[k]; \
+		i = left; \
+		j = right; \
+		do { \
+			while (local_buf[i] < pivot) i++; \
+			while (pivot < local_buf[j]) j--; \
+			if (i <= j) { \
+				temp = local_buf[i]; \
+				local_buf[i] = local_buf[j]; \
+				local_buf[j] = temp; \
+				i++; \
+				j--; \
+			} \
+		} \
+		while (i <= j); \
+		if (j < k) left = i; \
+		if (k < i) right = j; \
+	} \
+}
+
 /* GENERIC FUNCTION TO COMPUTE AVERAGE MEDIAN VALUE OF AN ARRAY.
  * @param data:				Input buffer.
  * @param median_length:	Number of elements taken for median value search.
@@ -62,27 +116,14 @@ static const uint32_t MATH_POW10[MATH_DECIMAL_MAX_LENGTH] = {1, 10, 100, 1000, 1
  * @return filter_out:		Output value of the median filter.
  */
 #define _MATH_median_filter(data, median_length, average_length) { \
-	uint8_t buffer_sorted = 0; \
 	uint8_t idx1 = 0; \
-	uint8_t idx2 = 0; \
 	/* Copy input buffer into local buffer */ \
 	for (idx1=0 ; idx1<median_length ; idx1++) { \
 		local_buf[idx1] = data[idx1]; \
 	} \
-	/* Sort buffer in ascending order. */ \
-	for (idx1=0; idx1<median_length; ++idx1) { \
-		buffer_sorted = 1; \
-		for (idx2=1 ; idx2<(median_length-idx1) ; ++idx2) { \
-			if (local_buf[idx2 - 1] > local_buf[idx2]) { \
-				temp = local_buf[idx2 - 1]; \
-				local_buf[idx2 - 1] = local_buf[idx2]; \
-				local_buf[idx2] = temp; \
-				buffer_sorted = 0; \
-			} \
-		} \
-		if (buffer_sorted != 0) break; \
-	} \
 	/* Compute start and end indexes for final averaging */ \
+	start_idx = (median_length / 2); \
+	end_idx = (median_length / 2); \
 	if (average_length > 0) { \
 		/* Clamp value */ \
 		if (average_length > median_length) { \
@@ -94,6 +135,19 @@ static const uint32_t MATH_POW10[MATH_DECIMAL_MAX_LENGTH] = {1, 10, 100, 1000, 1
 			end_idx = (median_length - 1); \
 		} \
 	} \
+	if ((median_length <= MATH_SORTING_NETWORK_LENGTH_MAX) && (MATH_SORTING_NETWORK_SIZE[median_length] != 0)) { \
+		/* Sort short buffers with a fixed sequence of comparisons */ \
+		for (idx1=0 ; idx1<MATH_SORTING_NETWORK_SIZE[median_length] ; idx1++) { \
+			_MATH_compare_exchange(MATH_SORTING_NETWORK[median_length][idx1][0], MATH_SORTING_NETWORK[median_length][idx1][1]); \
+		} \
+	} \
+	else if (median_length > 0) { \
+		/* Only place the center elements in other cases (each selection partitions the buffer around the selected element) */ \
+		_MATH_select(start_idx, 0, (median_length - 1)); \
+		for (idx1=(start_idx + 1) ; idx1<=end_idx ; idx1++) { \
+			_MATH_select(idx1, idx1, (median_length - 1)); \
+		} \
+	} \
 }
 
 /* GENERIC MACRO TO CHECK RESULT INPUT POINTER.
@@ -107,6 +161,29 @@ static const uint32_t MATH_POW10[MATH_DECIMAL_MAX_LENGTH] = {1, 10, 100, 1000, 1
 	} \
 }
 
+/* COMPUTE INTEGER SQUARE ROOT OF A 64-BITS VALUE.
+ * @param x:	Input value.
+ * @return:		Floor of the square root of x.
+ */
+static uint32_t _MATH_sqrt_u64(uint64_t x) {
+	// Local variables.
+	uint64_t result = 0;
+	uint64_t bit = ((uint64_t) 0b1) << 62;
+	// Bitwise computation (no division required).
+	while (bit > x) bit >>= 2;
+	while (bit != 0) {
+		if (x >= (result + bit)) {
+			x -= (result + bit);
+			result = (result >> 1) + bit;
+		}
+		else {
+			result >>= 1;
+		}
+		bit >>= 2;
+	}
+	return ((uint32_t) result);
+}
+
 /*** MATH functions ***/
 
 /* COMPUTE A POWER A 10.
@@ -321,6 +398,7 @@ errors:
 	MATH_status_t status = MATH_SUCCESS;
 	uint8_t local_buf[MATH_MEDIAN_FILTER_LENGTH_MAX];
 	uint8_t temp = 0;
+	uint8_t pivot = 0;
 	uint8_t start_idx = 0;
 	uint8_t end_idx = 0;
 	// Check parameters.
@@ -330,7 +408,7 @@ errors:
 	_MATH_median_filter(data, median_length, average_length);
 	// Compute average or median value.
 	if (average_length > 0) {
-		status = MATH_average_u8(&(data[start_idx]), (end_idx - start_idx + 1), result);
+		status = MATH_average_u8(&(local_buf[start_idx]), (end_idx - start_idx + 1), result);
 	}
 	else {
 		(*result) = local_buf[(median_length / 2)];
@@ -351,6 +429,7 @@ errors:
 	MATH_status_t status = MATH_SUCCESS;
 	uint16_t local_buf[MATH_MEDIAN_FILTER_LENGTH_MAX];
 	uint16_t temp = 0;
+	uint16_t pivot = 0;
 	uint8_t start_idx = 0;
 	uint8_t end_idx = 0;
 	// Check parameters.
@@ -360,7 +439,7 @@ errors:
 	_MATH_median_filter(data, median_length, average_length);
 	// Compute average or median value.
 	if (average_length > 0) {
-		status = MATH_average_u16(&(data[start_idx]), (end_idx - start_idx + 1), result);
+		status = MATH_average_u16(&(local_buf[start_idx]), (end_idx - start_idx + 1), result);
 	}
 	else {
 		(*result) = local_buf[(median_length / 2)];
@@ -381,6 +460,7 @@ errors:
 	MATH_status_t status = MATH_SUCCESS;
 	uint32_t local_buf[MATH_MEDIAN_FILTER_LENGTH_MAX];
 	uint32_t temp = 0;
+	uint32_t pivot = 0;
 	uint8_t start_idx = 0;
 	uint8_t end_idx = 0;
 	// Check parameters.
@@ -390,7 +470,7 @@ errors:
 	_MATH_median_filter(data, median_length, average_length);
 	// Compute average or median value.
 	if (average_length > 0) {
-		status = MATH_average_u32(&(data[start_idx]), (end_idx - start_idx + 1), result);
+		status = MATH_average_u32(&(local_buf[start_idx]), (end_idx - start_idx + 1), result);
 	}
 	else {
 		(*result) = local_buf[(median_length / 2)];
@@ -487,6 +567,91 @@ errors:
 	return status;
 }
 
+/* RESET STATISTICS ACCUMULATOR.
+ * @param statistics:	Pointer to the accumulator.
+ * @return status:		Function execution status.
+ */
+MATH_status_t MATH_statistics_reset(MATH_statistics_t* statistics) {
+	// Local variables.
+	MATH_status_t status = MATH_SUCCESS;
+	// Check parameters.
+	_MATH_check_pointer(statistics);
+	// Reset all fields.
+	(statistics -> count) = 0;
+	(statistics -> min) = 0;
+	(statistics -> max) = 0;
+	(statistics -> mean) = 0;
+	(statistics -> m2) = 0;
+errors:
+	return status;
+}
+
+/* ADD A SAMPLE TO A STATISTICS ACCUMULATOR (WELFORD ALGORITHM).
+ * @param statistics:	Pointer to the accumulator.
+ * @param value:		New sample.
+ * @return status:		Function execution status.
+ */
+MATH_status_t MATH_statistics_add(MATH_statistics_t* statistics, int32_t value) {
+	// Local variables.
+	MATH_status_t status = MATH_SUCCESS;
+	int32_t scaled_value = (value * MATH_STATISTICS_SCALE);
+	int32_t delta = 0;
+	int64_t product = 0;
+	// Check parameters.
+	_MATH_check_pointer(statistics);
+	if ((statistics -> count) == 0xFFFF) {
+		status = MATH_ERROR_OVERFLOW;
+		goto errors;
+	}
+	// First sample.
+	if ((statistics -> count) == 0) {
+		(statistics -> count) = 1;
+		(statistics -> min) = value;
+		(statistics -> max) = value;
+		(statistics -> mean) = scaled_value;
+		(statistics -> m2) = 0;
+		goto errors;
+	}
+	// Update extremas.
+	(statistics -> count)++;
+	if (value < (statistics -> min)) (statistics -> min) = value;
+	if (value > (statistics -> max)) (statistics -> max) = value;
+	// Update mean and sum of squared deviations.
+	delta = (scaled_value - (statistics -> mean));
+	(statistics -> mean) += (delta / ((int32_t) (statistics -> count)));
+	product = ((int64_t) delta) * ((int64_t) (scaled_value - (statistics -> mean)));
+	// Note: product is positive by construction, except truncation errors.
+	if (product > 0) {
+		(statistics -> m2) += (uint64_t) product;
+	}
+errors:
+	return status;
+}
+
+/* GET RESULT OF A STATISTICS ACCUMULATOR.
+ * @param statistics:	Pointer to the accumulator.
+ * @param result:		Pointer to the minimum, maximum, mean and standard deviation of the samples.
+ * @return status:		Function execution status.
+ */
+MATH_status_t MATH_statistics_get(MATH_statistics_t* statistics, MATH_statistics_result_t* result) {
+	// Local variables.
+	MATH_status_t status = MATH_SUCCESS;
+	// Check parameters.
+	_MATH_check_pointer(statistics);
+	_MATH_check_pointer(result);
+	if ((statistics -> count) == 0) {
+		status = MATH_ERROR_UNDEFINED;
+		goto errors;
+	}
+	// Unscale results.
+	(result -> min) = (statistics -> min);
+	(result -> max) = (statistics -> max);
+	(result -> mean) = ((statistics -> mean) / MATH_STATISTICS_SCALE);
+	(result -> standard_deviation) = ((_MATH_sqrt_u64((statistics -> m2) / (statistics -> count)) + (MATH_STATISTICS_SCALE / 2)) / MATH_STATISTICS_SCALE);
+errors:
+	return status;
+}
+
 /* COMPUTE THE TWO'S COMPLEMENT OF A GIVEN VALUE.
  * @param value:				Input unsigned value.
  * @param sign_bit_position:	Position of the sign bit in the input.
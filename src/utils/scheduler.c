@@ -0,0 +1,165 @@
+/*
+ * scheduler.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "scheduler.h"
+
+#include "event.h"
+#include "pwr.h"
+#include "rtc.h"
+#include "types.h"
+
+/*** SCHEDULER local structures ***/
+
+typedef struct {
+	const SCHEDULER_task_t* tasks; // Sorted by decreasing priority.
+	uint8_t tasks_count;
+	uint8_t current_task_index; // Equal to tasks_count when no task is running (idle).
+	SCHEDULER_statistics_t statistics[SCHEDULER_TASKS_MAX + 1]; // Last entry is the idle task.
+} SCHEDULER_context_t;
+
+/*** SCHEDULER local global variables ***/
+
+static SCHEDULER_context_t scheduler_ctx;
+
+/*** SCHEDULER local functions ***/
+
+/* COMPUTE TIME ELAPSED SINCE A TIME OF DAY.
+ * @param start_ms:		Time of day of the start.
+ * @return elapsed_ms:	Number of milliseconds elapsed since start (handles the day wrap).
+ */
+static uint32_t _SCHEDULER_get_elapsed_ms(uint32_t start_ms) {
+	// Local variables.
+	uint32_t now_ms = RTC_get_time_of_day_milliseconds();
+	// Check wrap.
+	return (now_ms >= start_ms) ? (now_ms - start_ms) : (now_ms + RTC_TIME_OF_DAY_MS_MAX - start_ms);
+}
+
+/*** SCHEDULER functions ***/
+
+/* INIT SCHEDULER.
+ * @param tasks:		Tasks table sorted by decreasing priority.
+ * @param tasks_count:	Number of tasks.
+ * @return status:		Function execution status.
+ */
+SCHEDULER_status_t SCHEDULER_init(const SCHEDULER_task_t* tasks, uint8_t tasks_count) {
+	// Local variables.
+	SCHEDULER_status_t status = SCHEDULER_SUCCESS;
+	uint8_t idx = 0;
+	// Check parameters.
+	if (tasks == NULL) {
+		status = SCHEDULER_ERROR_NULL_PARAMETER;
+		goto errors;
+	}
+	if ((tasks_count == 0) || (tasks_count > SCHEDULER_TASKS_MAX)) {
+		status = SCHEDULER_ERROR_TASKS_COUNT;
+		goto errors;
+	}
+	for (idx=0 ; idx<tasks_count ; idx++) {
+		if ((tasks[idx].ready == NULL) || (tasks[idx].run == NULL)) {
+			status = SCHEDULER_ERROR_NULL_PARAMETER;
+			goto errors;
+		}
+	}
+	// Init context.
+	scheduler_ctx.tasks = tasks;
+	scheduler_ctx.tasks_count = tasks_count;
+	scheduler_ctx.current_task_index = tasks_count;
+	for (idx=0 ; idx<=SCHEDULER_TASKS_MAX ; idx++) {
+		scheduler_ctx.statistics[idx].run_count = 0;
+		scheduler_ctx.statistics[idx].wake_count = 0;
+		scheduler_ctx.statistics[idx].active_time_ms = 0;
+		scheduler_ctx.statistics[idx].sleep_time_ms = 0;
+	}
+errors:
+	return status;
+}
+
+/* RUN THE HIGHEST PRIORITY READY TASK, OR ENTER STOP MODE IF NONE IS READY.
+ * @param:	None.
+ * @return:	None.
+ */
+void SCHEDULER_run(void) {
+	// Local variables.
+	SCHEDULER_statistics_t* statistics = NULL;
+	uint32_t start_ms = 0;
+	uint32_t sleep_time_ms = 0;
+	uint32_t elapsed_ms = 0;
+	uint8_t idx = 0;
+	// Select task.
+	for (idx=0 ; idx<scheduler_ctx.tasks_count ; idx++) {
+		if (scheduler_ctx.tasks[idx].ready() != 0) break;
+	}
+	// Idle.
+	if (idx >= scheduler_ctx.tasks_count) {
+		SCHEDULER_yield();
+		return;
+	}
+	// Run task until completion.
+	statistics = &(scheduler_ctx.statistics[idx]);
+	scheduler_ctx.current_task_index = idx;
+	start_ms = RTC_get_time_of_day_milliseconds();
+	sleep_time_ms = (statistics -> sleep_time_ms);
+	scheduler_ctx.tasks[idx].run();
+	// Update statistics.
+	elapsed_ms = _SCHEDULER_get_elapsed_ms(start_ms);
+	sleep_time_ms = ((statistics -> sleep_time_ms) - sleep_time_ms);
+	(statistics -> run_count)++;
+	(statistics -> active_time_ms) += (elapsed_ms > sleep_time_ms) ? (elapsed_ms - sleep_time_ms) : 0;
+	scheduler_ctx.current_task_index = scheduler_ctx.tasks_count;
+}
+
+/* YIELD POINT: ENTER STOP MODE UNTIL THE NEXT INTERRUPT AND DISPATCH PENDING EVENTS.
+ * @param:	None.
+ * @return:	None.
+ */
+void SCHEDULER_yield(void) {
+	// Local variables.
+	SCHEDULER_statistics_t* statistics = &(scheduler_ctx.statistics[scheduler_ctx.current_task_index]);
+	uint32_t start_ms = RTC_get_time_of_day_milliseconds();
+	// Enter stop mode unless an interrupt posted an event since the last dispatch (checked with interrupts masked to avoid missing the wake-up).
+	PWR_enter_stop_mode(&EVENT_is_pending);
+	// Wake-up.
+	EVENT_dispatch();
+	(statistics -> wake_count)++;
+	(statistics -> sleep_time_ms) += _SCHEDULER_get_elapsed_ms(start_ms);
+}
+
+/* CHECK IF A TASK WITH A HIGHER PRIORITY THAN THE RUNNING ONE IS READY.
+ * @param:	None.
+ * @return:	1 if the running task should return at its next safe point, 0 otherwise.
+ */
+uint8_t SCHEDULER_is_preemption_requested(void) {
+	// Local variables.
+	uint8_t idx = 0;
+	// Higher priority tasks loop.
+	for (idx=0 ; idx<scheduler_ctx.current_task_index ; idx++) {
+		if (scheduler_ctx.tasks[idx].ready() != 0) return 1;
+	}
+	return 0;
+}
+
+/* GET TASK STATISTICS.
+ * @param task_index:	Task index (tasks count for the idle task).
+ * @param statistics:	Pointer to the task statistics.
+ * @return status:		Function execution status.
+ */
+SCHEDULER_status_t SCHEDULER_get_statistics(uint8_t task_index, SCHEDULER_statistics_t* statistics) {
+	// Local variables.
+	SCHEDULER_status_t status = SCHEDULER_SUCCESS;
+	// Check parameters.
+	if (statistics == NULL) {
+		status = SCHEDULER_ERROR_NULL_PARAMETER;
+		goto errors;
+	}
+	if (task_index > scheduler_ctx.tasks_count) {
+		status = SCHEDULER_ERROR_TASK_INDEX;
+		goto errors;
+	}
+	(*statistics) = scheduler_ctx.statistics[task_index];
+errors:
+	return status;
+}